@@ -0,0 +1,83 @@
+#include "BandPool.h"
+
+// Starts bands - 1 worker threads
+BandPool::BandPool(int bandCount) : bands(bandCount > 1 ? bandCount : 1) {
+    for (int band = 1; band < bands; ++band) {
+        workers.emplace_back(&BandPool::WorkerLoop, this, band);
+    }
+}
+
+BandPool::~BandPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Call work(band) for every band in parallel and wait for all of them
+void BandPool::Run(const std::function<void(int band)>& bandWork) {
+    if (bands == 1) {
+        bandWork(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        work = &bandWork;
+        pending = bands - 1;
+        ++round;
+    }
+    started.notify_all();
+
+    bandWork(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pending == 0; });
+    work = nullptr;
+}
+
+// Rows [first, end) of a board `height` rows tall that belong to a band.
+// Boards with at least 64 rows per band put the inner boundaries on multiples of 64 rows, so
+// each band owns whole summary tiles. Shorter boards are split evenly instead; rounding there
+// would leave the leading bands empty.
+void BandPool::GetBandRows(int band, int bandCount, int height, int& first, int& end) {
+    bool ownTiles = BandsOwnTiles(bandCount, height);
+    auto boundary = [&](int index) {
+        if (index >= bandCount) return height;
+        int row = static_cast<int>(static_cast<long long>(height) * index / bandCount);
+        return ownTiles ? row / 64 * 64 : row;
+    };
+    first = boundary(band);
+    end = boundary(band + 1);
+}
+
+// Wait for each round of work and run this thread's band of it
+void BandPool::WorkerLoop(int band) {
+    long long seen = 0;
+    for (;;) {
+        const std::function<void(int)>* roundWork;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [&] { return stopping || round != seen; });
+            if (stopping) return;
+            seen = round;
+            roundWork = work;
+        }
+
+        (*roundWork)(band);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = --pending == 0;
+        }
+        if (last) {
+            finished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef BANDPOOL_H
+#define BANDPOOL_H
+
+#include <condition_variable>
+#include <functional>  // std::function for the work of one band
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads that each own one horizontal band of a board. Band i always runs on the same
+// thread (band 0 on the caller's), so the rows a thread clears first - which is where the OS
+// places their pages on a NUMA machine - are the rows it steps from then on, and stepping stays
+// on the local node.
+class BandPool {
+public:
+    explicit BandPool(int bands);                    // Starts bands - 1 worker threads
+    ~BandPool();
+
+    BandPool(const BandPool&) = delete;
+    BandPool& operator=(const BandPool&) = delete;
+
+    int GetBands() const { return bands; }
+
+    // Call work(band) for every band in parallel and wait for all of them
+    void Run(const std::function<void(int band)>& work);
+
+    // Rows [first, end) of a board `height` rows tall that belong to a band. Every band gets rows
+    // once height >= bands; inner boundaries fall on multiples of 64 rows when BandsOwnTiles.
+    static void GetBandRows(int band, int bands, int height, int& first, int& end);
+    static bool BandsOwnTiles(int bands, int height) { return height >= 64LL * bands; }
+
+private:
+    int bands = 1;
+    std::vector<std::thread> workers;                 // Worker i - 1 runs band i
+
+    std::mutex mutex;
+    std::condition_variable started;                  // Signals a new round of work
+    std::condition_variable finished;                 // Signals that the last band of a round is done
+    const std::function<void(int)>* work = nullptr;   // Work of the current round
+    long long round = 0;                              // Incremented for every Run
+    int pending = 0;                                  // Worker bands still running in this round
+    bool stopping = false;
+
+    void WorkerLoop(int band);
+};
+
+#endif // BANDPOOL_H
@@ -0,0 +1,265 @@
+#include "BitBoard.h"
+#include "BandPool.h"    // Threads for banded stepping
+#include "BitKernel.h"   // Bit-parallel rules used to step each word
+#include "SummaryIndex.h" // Tallies of the rows being written
+#include <algorithm>     // std::fill / std::copy / std::equal
+
+// Change the size, killing every cell (or, without `clear`, leaving the pages untouched)
+void BitBoard::Resize(int newWidth, int newHeight, bool clear) {
+    width = newWidth;
+    height = newHeight;
+    stride = (width + 63) / 64;
+    pitch = stride + 2;
+
+    // Hand a much bigger buffer back to the arena rather than keep it for a small board
+    size_t size = static_cast<size_t>(pitch) * (height + 2);
+    if (words.capacity() > 2 * size) {
+        decltype(words)().swap(words);
+    }
+
+    words.clear();
+    words.resize(size);  // Default-initialized by the arena allocator: nothing is written yet
+    if (clear) {
+        std::fill(words.begin(), words.end(), 0);
+    }
+}
+
+// Kill every cell
+void BitBoard::Clear() {
+    std::fill(words.begin(), words.end(), 0);
+}
+
+// Zero rows [firstRow, endRow), ghost words included
+void BitBoard::ClearRows(int firstRow, int endRow) {
+    std::fill(words.begin() + static_cast<size_t>(firstRow + 1) * pitch,
+              words.begin() + static_cast<size_t>(endRow + 1) * pitch, 0);
+}
+
+// Copy rows [firstRow, endRow), ghost words included, from a board of the same size
+void BitBoard::CopyRows(const BitBoard& source, int firstRow, int endRow) {
+    std::copy(source.words.begin() + static_cast<size_t>(firstRow + 1) * pitch,
+              source.words.begin() + static_cast<size_t>(endRow + 1) * pitch,
+              words.begin() + static_cast<size_t>(firstRow + 1) * pitch);
+}
+
+// Bits of the last word in a row that are on the board
+uint64_t BitBoard::LastWordMask() const {
+    return LowBits(width - (stride - 1) * 64);
+}
+
+// Count living cells
+long long BitBoard::Population() const {
+    long long population = 0;
+    for (int row = 0; row < height; ++row) {
+        const uint64_t* cells = Row(row);
+        for (int word = 0; word < stride; ++word) {
+            population += CountBits(cells[word]);
+        }
+    }
+    return population;
+}
+
+// Compares the cells only, never the ghost border
+bool BitBoard::operator==(const BitBoard& other) const {
+    if (width != other.width || height != other.height) return false;
+
+    for (int row = 0; row < height; ++row) {
+        if (!std::equal(Row(row), Row(row) + stride, other.Row(row))) return false;
+    }
+    return true;
+}
+
+// Set a row's ghost cells left and right of the board: column -1 is bit 63 of the left ghost
+// word, and column `width` is the first bit past the edge (in the last word or the right ghost word)
+void BitBoard::FillGhostColumns(uint64_t* cells, bool wrap) {
+    uint64_t left = wrap ? (cells[(width - 1) / 64] >> ((width - 1) % 64)) & 1 : 0;
+    uint64_t right = wrap ? cells[0] & 1 : 0;
+
+    cells[-1] = left << 63;
+    cells[stride] = 0;
+    cells[stride - 1] &= LastWordMask();               // Drop a ghost cell left over from an earlier fill
+    cells[width / 64] |= right << (width % 64);
+}
+
+// Copy a row flipped left to right: target column c is source column width - 1 - c
+void BitBoard::MirrorRow(const uint64_t* source, uint64_t* target) const {
+    for (int word = 0; word < stride; ++word) {
+        // The 64 source cells ending at column width - 1 - word * 64; the first may be in the left ghost word
+        int start = width - 64 - word * 64;
+        int first = start >= 0 ? start / 64 : -1;
+        int shift = start - first * 64;
+
+        uint64_t bits = source[first] >> shift;
+        if (shift > 0) {
+            bits |= source[first + 1] << (64 - shift);
+        }
+        target[word] = ReverseBits(bits);
+    }
+    target[stride - 1] &= LastWordMask();
+}
+
+// Fill the ghost border for one step
+void BitBoard::FillGhosts(Topology topology) {
+    if (width == 0 || height == 0) return;
+
+    bool wrapColumns = WrapsColumns(topology);
+    for (int row = 0; row < height; ++row) {
+        FillGhostColumns(Row(row), wrapColumns);
+    }
+
+    // Ghost rows are copied whole, ghost words included, so the corners come along
+    uint64_t* top = Row(-1) - 1;
+    uint64_t* bottom = Row(height) - 1;
+    switch (topology) {
+    case Topology::Toroidal:
+        std::copy(Row(height - 1) - 1, Row(height - 1) - 1 + pitch, top);
+        std::copy(Row(0) - 1, Row(0) - 1 + pitch, bottom);
+        break;
+    case Topology::KleinBottle:
+        MirrorRow(Row(height - 1), Row(-1));
+        MirrorRow(Row(0), Row(height));
+        FillGhostColumns(Row(-1), true);
+        FillGhostColumns(Row(height), true);
+        break;
+    case Topology::Finite:
+    case Topology::Cylinder:
+    default:
+        std::fill(top, top + pitch, 0);
+        std::fill(bottom, bottom + pitch, 0);
+        break;
+    }
+}
+
+// Make the ghost cells that share the last word of each row dead again
+void BitBoard::ClearGhosts() {
+    if (width % 64 == 0) return;  // The ghost cells have words of their own
+
+    uint64_t lastMask = LastWordMask();
+    for (int row = 0; row < height; ++row) {
+        Row(row)[stride - 1] &= lastMask;
+    }
+}
+
+// Read 64 cells starting at (row, col) anywhere on the plane, applying the topology
+uint64_t BitBoard::LoadWord(int row, int col, Topology topology) const {
+    bool mirrored;
+    if (width == 0 || !MapRow(row, height, topology, mirrored)) {
+        return 0;  // Entirely off a finite board
+    }
+
+    // A mirrored row holds the same 64 cells in reverse order, counted from the other edge
+    if (mirrored) {
+        return ReverseBits(LoadRowWord(row, width - 64 - col, WrapsColumns(topology)));
+    }
+    return LoadRowWord(row, col, WrapsColumns(topology));
+}
+
+// Read 64 cells starting at column `col` of a board row, wrapping around or reading dead cells past the edges
+uint64_t BitBoard::LoadRowWord(int row, int col, bool wrapColumns) const {
+    if (wrapColumns) {
+        col %= width;
+        if (col < 0) col += width;
+    }
+    else if (col <= -64 || col >= width) {
+        return 0;
+    }
+
+    const uint64_t* cells = Row(row);
+
+    // Aligned reads come straight out of the row (padding bits past the edge are dead)
+    if (col % 64 == 0 && (col + 64 <= width || (!wrapColumns && col >= 0))) {
+        return cells[col / 64];
+    }
+
+    // Straddling the edge: gather cell by cell
+    uint64_t word = 0;
+    for (int bit = 0; bit < 64; ++bit) {
+        int column = col + bit;
+        if (wrapColumns) {
+            column %= width;
+        }
+        else if (column < 0 || column >= width) {
+            continue;
+        }
+
+        if ((cells[column / 64] >> (column % 64)) & 1) {
+            word |= 1ULL << bit;
+        }
+    }
+    return word;
+}
+
+namespace {
+    // Step rows [firstRow, endRow) of a board whose ghost border has been filled.
+    // Every word's neighbors are plain reads; the only edge handling left is masking off the
+    // cells computed past the right edge. Each finished row is tallied while it is still in cache.
+    void StepRows(const BitBoard& in, BitBoard& out, int firstRow, int endRow, SummaryIndex* summary) {
+        int stride = in.GetStride();
+        uint64_t lastMask = in.LastWordMask();
+
+        for (int row = firstRow; row < endRow; ++row) {
+            const uint64_t* above = in.Row(row - 1);
+            const uint64_t* current = in.Row(row);
+            const uint64_t* below = in.Row(row + 1);
+            uint64_t* target = out.Row(row);
+
+            for (int word = 0; word < stride; ++word) {
+                target[word] = StepWord(above[word - 1], above[word], above[word + 1],
+                                        current[word - 1], current[word], current[word + 1],
+                                        below[word - 1], below[word], below[word + 1]);
+            }
+            target[stride - 1] &= lastMask;
+            if (summary) {
+                summary->TallyRow(row, target, 0, stride);
+            }
+        }
+    }
+}
+
+// Advance a packed board one generation, writing the result into `out`
+void StepBitBoard(BitBoard& in, BitBoard& out, Topology topology, SummaryIndex* summary) {
+    int width = in.GetWidth();
+    int height = in.GetHeight();
+    if (out.GetWidth() != width || out.GetHeight() != height) {
+        out.Resize(width, height);
+    }
+    if (width == 0 || height == 0) return;
+
+    in.FillGhosts(topology);
+    StepRows(in, out, 0, height, summary);
+    in.ClearGhosts();
+}
+
+// The same, with each band of rows stepped by its own thread of the pool. The ghost border is
+// still filled by the calling thread; it is a few words per row. When the bands own whole
+// summary tiles the threads tally into separate leaves; on boards too short for that, bands
+// would share leaves, so the calling thread tallies the (few) rows once the bands are done.
+void StepBitBoard(BitBoard& in, BitBoard& out, Topology topology, BandPool& bands, SummaryIndex* summary) {
+    int width = in.GetWidth();
+    int height = in.GetHeight();
+    if (out.GetWidth() != width || out.GetHeight() != height) {
+        // Let every band thread place its own rows of the new sandbox
+        out.Resize(width, height, false);
+        bands.Run([&](int band) {
+            int first, end;
+            BandPool::GetBandRows(band, bands.GetBands(), height, first, end);
+            out.ClearRows(band == 0 ? -1 : first, band == bands.GetBands() - 1 ? height + 1 : end);
+        });
+    }
+    if (width == 0 || height == 0) return;
+
+    in.FillGhosts(topology);
+    bool bandTallies = BandPool::BandsOwnTiles(bands.GetBands(), height);
+    bands.Run([&](int band) {
+        int first, end;
+        BandPool::GetBandRows(band, bands.GetBands(), height, first, end);
+        StepRows(in, out, first, end, bandTallies ? summary : nullptr);
+    });
+    in.ClearGhosts();
+
+    if (summary && !bandTallies) {
+        for (int row = 0; row < height; ++row) {
+            summary->TallyRow(row, out.Row(row), 0, out.GetStride());
+        }
+    }
+}
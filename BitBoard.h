@@ -0,0 +1,101 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "BoardArena.h" // Arena allocator for the packed words
+#include "Topology.h"  // How the board edges are joined
+#include <cstddef>     // size_t
+#include <cstdint>     // Fixed-width integer types for packed cell words
+#include <utility>     // std::swap
+#include <vector>      // STL vector for the packed rows
+
+class BandPool;        // Threads for banded stepping
+class SummaryIndex;    // Tallies the generation a step writes
+
+// In-memory game board with cells packed 64 to a word, row after row.
+// Bit j of word w in a row is column w * 64 + j. Bits past the right edge of the
+// board are always kept dead, so whole words can be compared and counted.
+//
+// Every row has a ghost word on each side, and there is a ghost row above and below the
+// board. FillGhosts() copies the cells they stand for under a topology onto them, so a step
+// can read every neighbor directly without checking for the board edge.
+//
+// Large boards take their words from the BoardArena. Resize(width, height, false) leaves them
+// untouched so that banded stepping can clear each band from the thread that will step it.
+class BitBoard {
+public:
+    BitBoard() { Resize(0, 0); }
+    BitBoard(int width, int height) { Resize(width, height); }
+
+    // Change the size, killing every cell. With `clear` false the words (ghost border included)
+    // are left undefined, and ClearRows or CopyRows must cover every row from -1 to height.
+    void Resize(int newWidth, int newHeight, bool clear = true);
+    void Clear();                                    // Kill every cell
+    void ClearRows(int firstRow, int endRow);        // Zero rows [firstRow, endRow), ghost words included (-1 and height are the ghost rows)
+    void CopyRows(const BitBoard& source, int firstRow, int endRow);  // Same, copying from a board of the same size
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    int GetStride() const { return stride; }         // Words of cells per row
+    int GetPitch() const { return pitch; }           // Words from the start of one row to the next (stride plus the ghost words)
+    const void* GetData() const { return words.data(); }  // Start of the words, ghost border included
+    size_t GetSizeBytes() const { return words.size() * sizeof(uint64_t); }
+
+    bool GetCell(int row, int col) const {
+        return (Row(row)[col / 64] >> (col % 64)) & 1;
+    }
+
+    void SetCell(int row, int col, bool alive) {
+        uint64_t& word = Row(row)[col / 64];
+        uint64_t bit = 1ULL << (col % 64);
+        word = alive ? (word | bit) : (word & ~bit);
+    }
+
+    // Rows -1 and height are the ghost rows; words -1 and stride of each row are its ghost words
+    uint64_t* Row(int row) { return &words[static_cast<size_t>(row + 1) * pitch + 1]; }
+    const uint64_t* Row(int row) const { return &words[static_cast<size_t>(row + 1) * pitch + 1]; }
+
+    uint64_t LastWordMask() const;                   // Bits of the last word in a row that are on the board
+    long long Population() const;                    // Count living cells
+
+    // Fill the ghost border for one step. When the width isn't a multiple of 64 the ghost
+    // cells past the right edge share the last word of each row, so ClearGhosts() must be
+    // called after the step to make those bits dead again.
+    void FillGhosts(Topology topology);
+    void ClearGhosts();
+
+    // Read 64 cells starting at (row, col) anywhere on the plane, applying the topology
+    uint64_t LoadWord(int row, int col, Topology topology) const;
+
+    bool operator==(const BitBoard& other) const;    // Compares the cells only, never the ghost border
+    bool operator!=(const BitBoard& other) const { return !(*this == other); }
+
+    void Swap(BitBoard& other) {
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(stride, other.stride);
+        std::swap(pitch, other.pitch);
+        words.swap(other.words);
+    }
+
+private:
+    int width = 0;                                   // Board width in cells
+    int height = 0;                                  // Board height in cells
+    int stride = 0;                                  // Words of cells per row
+    int pitch = 0;                                   // Words per row including the two ghost words
+    std::vector<uint64_t, ArenaAllocator<uint64_t>> words;  // Packed cells and ghost border, row-major
+
+    void FillGhostColumns(uint64_t* cells, bool wrap);  // Set a row's ghost cells left and right of the board
+    void MirrorRow(const uint64_t* source, uint64_t* target) const;  // Copy a row flipped left to right
+    uint64_t LoadRowWord(int row, int col, bool wrapColumns) const;  // LoadWord within one board row
+};
+
+// Advance a packed board one generation, writing the result into `out`.
+// Fills (and afterwards clears) the ghost border of `in`; its cells are left unchanged.
+// With a summary index, every row written is also tallied into it (between BeginTallies
+// and CommitTallies, which the caller runs).
+void StepBitBoard(BitBoard& in, BitBoard& out, Topology topology, SummaryIndex* summary = nullptr);
+
+// The same, with each band of rows stepped by its own thread of the pool
+void StepBitBoard(BitBoard& in, BitBoard& out, Topology topology, BandPool& bands, SummaryIndex* summary = nullptr);
+
+#endif // BITBOARD_H
@@ -0,0 +1,97 @@
+#include "BitEngine.h"
+
+BitEngine::BitEngine(bool useBlocking)
+    : summary([this](int tileRow, int tileCol, uint64_t* words) {
+          for (int i = 0; i < SummaryIndex::TileSize; ++i) {
+              int row = tileRow * SummaryIndex::TileSize + i;
+              words[i] = row < board.GetHeight() ? board.Row(row)[tileCol] : 0;
+          }
+          return true;
+      }),
+      isBlocked(useBlocking) {
+}
+
+// Change the board size, killing every cell. With band threads each thread clears its own rows
+// of both boards, so their pages land on the thread's NUMA node.
+void BitEngine::Resize(int width, int height) {
+    summary.Resize(width, height);
+    if (!bands || isBlocked) {
+        board.Resize(width, height);
+        return;
+    }
+
+    board.Resize(width, height, false);
+    sandbox.Resize(width, height, false);
+    bands->Run([&](int band) {
+        int first, end;
+        BandPool::GetBandRows(band, bands->GetBands(), height, first, end);
+        if (band == 0) first = -1;                           // Ghost rows go with the outer bands
+        if (band == bands->GetBands() - 1) end = height + 1;
+        board.ClearRows(first, end);
+        sandbox.ClearRows(first, end);
+    });
+}
+
+// Edit one cell and mark its tile for the summary
+void BitEngine::SetCell(int row, int col, bool alive) {
+    board.SetCell(row, col, alive);
+    summary.Invalidate(row, col);
+}
+
+// Kill every cell
+void BitEngine::Clear() {
+    board.Clear();
+    summary.Resize(board.GetWidth(), board.GetHeight());
+}
+
+// Band threads for unblocked stepping
+void BitEngine::SetThreads(int threads) {
+    bands.reset(threads > 1 ? new BandPool(threads) : nullptr);
+}
+
+// Advance the board by a number of generations. Once the summary has been queried, the kernels
+// tally the last generation as they write it, so only the summary leaves that changed are
+// rewritten; until then the summary is just marked stale.
+void BitEngine::Step(int generations) {
+    if (generations <= 0) return;
+
+    SummaryIndex* tallies = summary.IsQueried() ? &summary : nullptr;
+    if (tallies) {
+        summary.BeginTallies();
+    }
+
+    if (isBlocked) {
+        stepper.Step(board, generations, topology, tallies);
+    }
+    else {
+        for (int i = 0; i < generations; ++i) {
+            SummaryIndex* lastTallies = i == generations - 1 ? tallies : nullptr;
+            if (bands) {
+                StepBitBoard(board, sandbox, topology, *bands, lastTallies);
+            }
+            else {
+                StepBitBoard(board, sandbox, topology, lastTallies);
+            }
+            board.Swap(sandbox);
+        }
+    }
+
+    if (tallies) {
+        summary.CommitTallies();
+    }
+    else {
+        summary.Invalidate();
+    }
+}
+
+// Hash the packed rows directly; they already use the shared layout
+uint64_t BitEngine::Hash() const {
+    uint64_t hash = HashSeed(board.GetWidth(), board.GetHeight());
+    for (int row = 0; row < board.GetHeight(); ++row) {
+        const uint64_t* words = board.Row(row);
+        for (int word = 0; word < board.GetStride(); ++word) {
+            hash = HashWord(hash, words[word]);
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,55 @@
+#ifndef BITENGINE_H
+#define BITENGINE_H
+
+#include "LifeEngine.h"
+#include "BandPool.h"
+#include "BitBoard.h"
+#include "BlockedStepper.h"
+#include "SummaryIndex.h"
+#include <memory>  // std::unique_ptr for the optional band threads
+
+// Engine over a packed BitBoard, stepping 64 cells per word operation.
+// With blocking enabled, large boards are stepped by the cache-blocked BlockedStepper.
+// Without it, SetThreads splits the board into horizontal bands, each cleared (and so placed
+// on its NUMA node) and stepped by its own thread.
+// Region queries go through a SummaryIndex, read straight from the packed words: every tile is
+// re-summarized on the first query after a step, and only the edited tiles after SetCell.
+class BitEngine : public LifeEngine {
+public:
+    explicit BitEngine(bool useBlocking);
+
+    const char* GetName() const override { return isBlocked ? "Cache-blocked" : "Bit-parallel"; }
+
+    void Resize(int width, int height) override;
+    int GetWidth() const override { return board.GetWidth(); }
+    int GetHeight() const override { return board.GetHeight(); }
+    void SetTopology(Topology newTopology) override { topology = newTopology; }
+
+    bool GetCell(int row, int col) const override { return board.GetCell(row, col); }
+    void SetCell(int row, int col, bool alive) override;
+    void Clear() override;
+
+    void Step(int generations) override;
+    long long Population() const override { return board.Population(); }
+    uint64_t Hash() const override;
+
+    long long CountRegion(int row, int col, int rows, int cols) const override { return summary.CountRegion(row, col, rows, cols); }
+    bool GetLiveBounds(int& top, int& left, int& bottom, int& right) const override { return summary.GetLiveBounds(top, left, bottom, right); }
+    bool FindNextLiveCell(int& row, int& col) const override { return summary.FindNextLiveCell(row, col); }
+
+    const BitBoard& GetBoard() const { return board; }
+    void ConfigureCache(size_t cacheBytes) { stepper.Configure(cacheBytes); }  // Override the detected cache size
+    void SetThreads(int threads);                    // Band threads for unblocked stepping; call before Resize
+    int GetThreads() const { return bands ? bands->GetBands() : 1; }
+
+private:
+    BitBoard board;                                   // Current generation
+    BitBoard sandbox;                                 // Next generation while stepping unblocked
+    BlockedStepper stepper;                           // Used when blocking is enabled
+    std::unique_ptr<BandPool> bands;                  // Band threads, if more than one
+    mutable SummaryIndex summary;                     // Tallied by the step kernels; edited tiles are re-read by the queries
+    bool isBlocked = false;
+    Topology topology = Topology::Finite;             // How the board edges are joined
+};
+
+#endif // BITENGINE_H
@@ -0,0 +1,116 @@
+#ifndef BITKERNEL_H
+#define BITKERNEL_H
+
+#include <cstdint>  // Fixed-width integer types for packed cell words
+#if defined(_MSC_VER)
+#include <intrin.h> // __popcnt64 / _BitScanForward64 / _BitScanReverse64
+#endif
+
+// Bit-parallel Game of Life rules: each 64-bit word holds 64 horizontally adjacent cells,
+// bit j being column j of the word. One call computes the next state of all 64 cells at once.
+
+// Add three one-bit-per-lane values, producing a sum bit and a carry bit per lane
+inline void FullAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t& sum, uint64_t& carry) {
+    uint64_t partial = a ^ b;
+    sum = partial ^ c;
+    carry = (a & b) | (partial & c);
+}
+
+// Apply B3/S23 to every lane given the eight neighbor masks and the current state
+inline uint64_t ApplyRule(uint64_t n0, uint64_t n1, uint64_t n2, uint64_t n3,
+                          uint64_t n4, uint64_t n5, uint64_t n6, uint64_t n7, uint64_t alive) {
+    uint64_t sumA, carryA, sumB, carryB;
+    FullAdd(n0, n1, n2, sumA, carryA);
+    FullAdd(n3, n4, n5, sumB, carryB);
+    uint64_t sumC = n6 ^ n7, carryC = n6 & n7;
+
+    uint64_t ones, carryD, twosPartial, fours;
+    FullAdd(sumA, sumB, sumC, ones, carryD);               // Weight-1 bit of the count
+    FullAdd(carryA, carryB, carryC, twosPartial, fours);   // Weight-2 partial sum and a weight-4 carry
+
+    uint64_t twos = twosPartial ^ carryD;
+    fours |= twosPartial & carryD;                         // Any weight-4 bit means four or more neighbors
+
+    // Exactly two neighbors keeps a live cell alive, exactly three is a birth or survival
+    return twos & ~fours & (ones | alive);
+}
+
+// Next state of a word of cells, given the words above (north), level with (west/east)
+// and below (south) it. Only the edge bits of the diagonal/side words are used.
+inline uint64_t StepWord(uint64_t nw, uint64_t n, uint64_t ne,
+                         uint64_t w, uint64_t c, uint64_t e,
+                         uint64_t sw, uint64_t s, uint64_t se) {
+    return ApplyRule(
+        (n << 1) | (nw >> 63), n, (n >> 1) | (ne << 63),
+        (c << 1) | (w >> 63), (c >> 1) | (e << 63),
+        (s << 1) | (sw >> 63), s, (s >> 1) | (se << 63),
+        c);
+}
+
+// Mask with the lowest `count` bits set (count in 0..64)
+inline uint64_t LowBits(int count) {
+    return count >= 64 ? ~0ULL : ((1ULL << count) - 1);
+}
+
+// Population count of a word, portable across compilers
+inline int CountBits(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(word));
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Index of the lowest set bit (word must not be zero)
+inline int LowestBit(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// Index of the highest set bit (word must not be zero)
+inline int HighestBit(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(word);
+#else
+    int index = 63;
+    while ((word >> index) == 0) {
+        --index;
+    }
+    return index;
+#endif
+}
+
+// Mirror a word left to right: bit j moves to bit 63 - j
+inline uint64_t ReverseBits(uint64_t word) {
+    word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+    word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+    word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    word = ((word >> 8) & 0x00FF00FF00FF00FFULL) | ((word & 0x00FF00FF00FF00FFULL) << 8);
+    word = ((word >> 16) & 0x0000FFFF0000FFFFULL) | ((word & 0x0000FFFF0000FFFFULL) << 16);
+    return (word >> 32) | (word << 32);
+}
+
+#endif // BITKERNEL_H
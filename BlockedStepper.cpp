@@ -0,0 +1,206 @@
+#include "BlockedStepper.h"
+#include "BitKernel.h"   // Bit-parallel rules used to step each word
+#include "SummaryIndex.h" // Tallies of the centers written back
+#include <algorithm>     // std::min / std::max
+
+#ifdef _WIN32
+#define NOMINMAX         // Keep windows.h from defining min/max macros
+#include <windows.h>     // GetLogicalProcessorInformation
+#else
+#include <unistd.h>      // sysconf
+#endif
+
+namespace {
+    const size_t DefaultCacheBytes = 256 * 1024;   // Used when the L2 size can't be detected
+    const int DefaultTileWords = 16;               // 1024 columns per tile
+
+    // Next state of one row of a tile, given the rows above and below it.
+    // The words just outside the tile are treated as dead; the halo absorbs the error.
+    void StepLocalRow(const uint64_t* above, const uint64_t* current, const uint64_t* below,
+                      uint64_t* out, int words) {
+        if (words == 1) {
+            out[0] = StepWord(0, above[0], 0, 0, current[0], 0, 0, below[0], 0);
+            return;
+        }
+
+        out[0] = StepWord(0, above[0], above[1], 0, current[0], current[1], 0, below[0], below[1]);
+        for (int word = 1; word < words - 1; ++word) {
+            out[word] = StepWord(above[word - 1], above[word], above[word + 1],
+                                 current[word - 1], current[word], current[word + 1],
+                                 below[word - 1], below[word], below[word + 1]);
+        }
+        int last = words - 1;
+        out[last] = StepWord(above[last - 1], above[last], 0, current[last - 1], current[last], 0, below[last - 1], below[last], 0);
+    }
+}
+
+// Tunes itself for the detected L2 cache size
+BlockedStepper::BlockedStepper() {
+    Configure(DetectCacheSize());
+}
+
+// Size of the L2 cache (or a safe default)
+size_t BlockedStepper::DetectCacheSize() {
+#ifdef _WIN32
+    DWORD bufferLength = 0;
+    GetLogicalProcessorInformation(nullptr, &bufferLength);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(bufferLength / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!info.empty() && GetLogicalProcessorInformation(info.data(), &bufferLength)) {
+        for (const auto& entry : info) {
+            if (entry.Relationship == RelationCache && entry.Cache.Level == 2 && entry.Cache.Type != CacheInstruction) {
+                return entry.Cache.Size;
+            }
+        }
+    }
+#elif defined(_SC_LEVEL2_CACHE_SIZE)
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) {
+        return static_cast<size_t>(size);
+    }
+#endif
+    return DefaultCacheBytes;
+}
+
+// Pick depth and tile shape for a given cache size
+void BlockedStepper::Configure(size_t bytes) {
+    cacheBytes = bytes;
+
+    // The two local copies of a tile get half the cache; the other half is left for the
+    // rows being written back and whatever else is running
+    size_t perBuffer = cacheBytes / 4;
+    tileWords = DefaultTileWords;
+    int localRows = static_cast<int>(perBuffer / ((tileWords + 2) * sizeof(uint64_t)));
+    localRows = std::max(localRows, 16);
+
+    // Deeper halos save more memory traffic but recompute more rows; a tenth of the
+    // local rows keeps the recomputed share around 12%. The one-word horizontal halo
+    // caps the depth at 64.
+    depth = std::max(1, std::min(64, localRows / 10));
+    tileRows = localRows - 2 * depth;
+}
+
+// Advance the board in place. With a summary index, the generation left on the board is
+// tallied into it as the last pass writes it back.
+void BlockedStepper::Step(BitBoard& board, int generations, Topology topology, SummaryIndex* summary) {
+    if (board.GetWidth() == 0 || board.GetHeight() == 0) return;
+
+    // A board that already fits in cache next to its sandbox gains nothing from blocking
+    size_t boardBytes = static_cast<size_t>(board.GetStride()) * board.GetHeight() * sizeof(uint64_t);
+    if (depth <= 1 || boardBytes * 2 <= cacheBytes / 2) {
+        for (int i = 0; i < generations; ++i) {
+            StepBitBoard(board, sandbox, topology, i == generations - 1 ? summary : nullptr);
+            board.Swap(sandbox);
+        }
+        return;
+    }
+
+    int rows = std::min(tileRows, board.GetHeight());
+    int words = std::min(tileWords, board.GetStride());
+
+    while (generations > 0) {
+        int passGenerations = std::min(depth, generations);
+        generations -= passGenerations;
+        Pass(board, passGenerations, topology, rows, words, generations == 0 ? summary : nullptr);
+    }
+}
+
+// Advance every tile by up to `depth` generations, then swap the sandbox in
+void BlockedStepper::Pass(BitBoard& board, int generations, Topology topology, int rows, int words, SummaryIndex* summary) {
+    int width = board.GetWidth();
+    int height = board.GetHeight();
+    int stride = board.GetStride();
+    uint64_t lastMask = board.LastWordMask();
+    bool raggedEdge = width % 64 != 0;
+    bool wrapColumns = WrapsColumns(topology);
+    bool wrapRows = WrapsRows(topology);
+
+    if (sandbox.GetWidth() != width || sandbox.GetHeight() != height) {
+        sandbox.Resize(width, height);
+    }
+
+    int maxLocalWidth = words + 2;
+    size_t maxLocalSize = static_cast<size_t>(rows + 2 * generations) * maxLocalWidth;
+    localCurrent.resize(maxLocalSize);
+    localNext.resize(maxLocalSize);
+    std::vector<uint64_t> columnMask(maxLocalWidth);
+
+    for (int tileRow = 0; tileRow < height; tileRow += rows) {
+        int tileHeight = std::min(rows, height - tileRow);
+        int localRows = tileHeight + 2 * generations;
+        int firstRow = tileRow - generations;
+
+        for (int tileWord = 0; tileWord < stride; tileWord += words) {
+            int tileWidth = std::min(words, stride - tileWord);
+            int localWidth = tileWidth + 2;
+            int firstWord = tileWord - 1;
+
+            // Past a finite left/right edge, cells must stay dead in every local generation
+            for (int j = 0; j < localWidth; ++j) {
+                int word = firstWord + j;
+                if (wrapColumns) {
+                    columnMask[j] = ~0ULL;
+                }
+                else if (word < 0 || word >= stride) {
+                    columnMask[j] = 0;
+                }
+                else {
+                    columnMask[j] = word == stride - 1 ? lastMask : ~0ULL;
+                }
+            }
+
+            // Load the tile and its halo; words that cross the board edge go through LoadWord and the topology
+            for (int i = 0; i < localRows; ++i) {
+                int boardRow = firstRow + i;
+                uint64_t* local = &localCurrent[static_cast<size_t>(i) * localWidth];
+                bool rowInside = boardRow >= 0 && boardRow < height;
+                const uint64_t* source = rowInside ? board.Row(boardRow) : nullptr;
+
+                for (int j = 0; j < localWidth; ++j) {
+                    int word = firstWord + j;
+                    bool direct = rowInside && word >= 0 && word < stride && !(wrapColumns && raggedEdge && word == stride - 1);
+                    local[j] = direct ? source[word] : board.LoadWord(boardRow, word * 64, topology);
+                }
+            }
+
+            // Advance the tile while it is cache resident; the valid region shrinks by a row each generation
+            for (int generation = 1; generation <= generations; ++generation) {
+                for (int i = generation; i < localRows - generation; ++i) {
+                    uint64_t* out = &localNext[static_cast<size_t>(i) * localWidth];
+                    int boardRow = firstRow + i;
+
+                    if (!wrapRows && (boardRow < 0 || boardRow >= height)) {
+                        std::fill(out, out + localWidth, 0);
+                        continue;
+                    }
+
+                    StepLocalRow(&localCurrent[static_cast<size_t>(i - 1) * localWidth],
+                                 &localCurrent[static_cast<size_t>(i) * localWidth],
+                                 &localCurrent[static_cast<size_t>(i + 1) * localWidth],
+                                 out, localWidth);
+
+                    if (!wrapColumns) {
+                        for (int j = 0; j < localWidth; ++j) out[j] &= columnMask[j];
+                    }
+                }
+                localCurrent.swap(localNext);
+            }
+
+            // Write the center back into the sandbox
+            for (int i = 0; i < tileHeight; ++i) {
+                const uint64_t* center = &localCurrent[static_cast<size_t>(generations + i) * localWidth + 1];
+                uint64_t* target = sandbox.Row(tileRow + i) + tileWord;
+                for (int j = 0; j < tileWidth; ++j) {
+                    target[j] = center[j];
+                }
+                if (tileWord + tileWidth == stride) {
+                    target[tileWidth - 1] &= lastMask;  // Drop wrapped cells past the right edge
+                }
+                if (summary) {
+                    summary->TallyRow(tileRow + i, sandbox.Row(tileRow + i), tileWord, tileWord + tileWidth);
+                }
+            }
+        }
+    }
+
+    board.Swap(sandbox);
+}
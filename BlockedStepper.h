@@ -0,0 +1,45 @@
+#ifndef BLOCKEDSTEPPER_H
+#define BLOCKEDSTEPPER_H
+
+#include "BitBoard.h"
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <vector>
+
+// Cache-blocked (temporally blocked) stepping for large packed boards.
+//
+// Stepping one generation at a time streams the whole board and its sandbox through DRAM
+// every generation. Instead, the board is cut into tiles; each tile is loaded together with
+// a halo `depth` rows deep and one word wide, advanced `depth` generations while it sits in
+// L1/L2, and only its center is written back. The halo is recomputed by neighboring tiles,
+// which costs a little extra arithmetic but divides memory traffic by roughly `depth`.
+// The halo plays the part of the ghost border: past a joined edge it is loaded from the
+// cells that edge leads to, and past a finite edge it is kept dead every generation.
+class BlockedStepper {
+public:
+    BlockedStepper();                                // Tunes itself for the detected L2 cache size
+
+    void Configure(size_t cacheBytes);               // Pick depth and tile shape for a given cache size
+    void Step(BitBoard& board, int generations, Topology topology, SummaryIndex* summary = nullptr);  // Advance the board in place (tallying the last generation)
+
+    int GetDepth() const { return depth; }           // Generations advanced per tile load
+    int GetTileRows() const { return tileRows; }     // Rows written back per tile
+    int GetTileWords() const { return tileWords; }   // Words (64 cells) written back per tile row
+    size_t GetCacheBytes() const { return cacheBytes; }
+
+    static size_t DetectCacheSize();                 // Size of the L2 cache (or a safe default)
+
+private:
+    size_t cacheBytes = 0;                           // Cache size the tile shape was chosen for
+    int depth = 1;                                   // Generations advanced per tile load (at most 64)
+    int tileRows = 0;
+    int tileWords = 0;
+
+    BitBoard sandbox;                                // Receives the tiles' centers; swapped with the board after each pass
+    std::vector<uint64_t> localCurrent;              // Tile plus halo, generation being read
+    std::vector<uint64_t> localNext;                 // Tile plus halo, generation being written
+
+    void Pass(BitBoard& board, int generations, Topology topology, int rows, int words, SummaryIndex* summary);  // Advance every tile by up to `depth` generations
+};
+
+#endif // BLOCKEDSTEPPER_H
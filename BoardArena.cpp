@@ -0,0 +1,291 @@
+#include "BoardArena.h"
+#include <cctype>        // std::tolower
+#include <cstdint>       // uintptr_t
+
+#ifdef _WIN32
+#define NOMINMAX         // Keep windows.h from defining min/max macros
+#include <windows.h>     // VirtualAlloc / VirtualFree
+#include <psapi.h>       // QueryWorkingSetEx (K32QueryWorkingSetEx in kernel32)
+#else
+#include <sys/mman.h>    // mmap / munmap / madvise
+#include <unistd.h>      // sysconf
+#ifdef __linux__
+#include <sys/syscall.h> // SYS_move_pages, for asking which node a page is on
+#endif
+#endif
+
+namespace {
+    const char* HugePagesNames[HugePagesCount] = { "Off", "Transparent", "Explicit" };
+
+    const size_t HugePageBytes = 2 * 1024 * 1024;     // Huge page size on x86-64 (and transparent huge page alignment)
+
+    size_t PageSize() {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+    }
+
+    size_t RoundUp(size_t bytes, size_t granularity) {
+        return (bytes + granularity - 1) / granularity * granularity;
+    }
+
+#ifdef _WIN32
+    // Large pages need SeLockMemoryPrivilege enabled in the process token (and granted to the user)
+    bool EnableLargePages() {
+        static const bool enabled = [] {
+            HANDLE token;
+            if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+                return false;
+            }
+
+            TOKEN_PRIVILEGES privileges = {};
+            privileges.PrivilegeCount = 1;
+            privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+            bool granted = LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                GetLastError() == ERROR_SUCCESS;
+            CloseHandle(token);
+            return granted;
+        }();
+        return enabled;
+    }
+#endif
+}
+
+// Name shown by the CLI
+const char* GetHugePagesName(HugePages mode) {
+    int index = static_cast<int>(mode);
+    return index >= 0 && index < HugePagesCount ? HugePagesNames[index] : "Unknown";
+}
+
+// Inverse of GetHugePagesName (case-insensitive)
+bool ParseHugePages(const std::string& name, HugePages& mode) {
+    for (int index = 0; index < HugePagesCount; ++index) {
+        std::string candidate = HugePagesNames[index];
+        if (candidate.size() != name.size()) continue;
+
+        bool same = true;
+        for (size_t i = 0; i < name.size() && same; ++i) {
+            same = std::tolower(static_cast<unsigned char>(name[i])) == std::tolower(static_cast<unsigned char>(candidate[i]));
+        }
+        if (same) {
+            mode = static_cast<HugePages>(index);
+            return true;
+        }
+    }
+    return false;
+}
+
+// The arena shared by every board. It is never destroyed, so boards with static storage can
+// still release into it during exit; the OS takes the mappings back.
+BoardArena& BoardArena::Get() {
+    static BoardArena* arena = new BoardArena();
+    return *arena;
+}
+
+void BoardArena::SetHugePages(HugePages mode) {
+    std::lock_guard<std::mutex> lock(mutex);
+    hugePages = mode;
+}
+
+HugePages BoardArena::GetHugePages() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hugePages;
+}
+
+// Most released bytes kept for reuse
+void BoardArena::SetCacheLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cacheLimit = bytes;
+}
+
+ArenaStats BoardArena::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+// Hand out a cached buffer of the same size, or map a new one
+void* BoardArena::Acquire(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool huge = hugePages != HugePages::Off && bytes >= HugePageBytes;
+    size_t size = RoundUp(bytes, huge ? HugePageBytes : PageSize());
+
+    Mapping mapping;
+    for (size_t i = 0; i < cached.size(); ++i) {
+        if (cached[i].size == size) {
+            mapping = cached[i];
+            cached.erase(cached.begin() + i);
+            stats.cachedBytes -= mapping.size;
+            ++stats.reused;
+            break;
+        }
+    }
+
+    if (!mapping.base) {
+        mapping = Map(size);
+        if (!mapping.base) {
+            return nullptr;
+        }
+        stats.mappedBytes += mapping.size;
+        stats.hugePageBytes += mapping.huge ? mapping.size : 0;
+    }
+
+    ++stats.acquired;
+    live[mapping.base] = mapping;
+    return mapping.base;
+}
+
+// Keep a released buffer for reuse, dropping the oldest ones past the cache limit
+void BoardArena::Release(void* block) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = live.find(block);
+    if (it == live.end()) return;  // Not one of ours
+
+    cached.push_back(it->second);
+    stats.cachedBytes += it->second.size;
+    live.erase(it);
+
+    while (stats.cachedBytes > cacheLimit) {
+        Mapping& oldest = cached.front();
+        stats.cachedBytes -= oldest.size;
+        stats.mappedBytes -= oldest.size;
+        stats.hugePageBytes -= oldest.huge ? oldest.size : 0;
+        Unmap(oldest);
+        cached.erase(cached.begin());
+    }
+}
+
+// Ask the OS for a new mapping. Nothing is written to it, so no page is placed yet.
+BoardArena::Mapping BoardArena::Map(size_t bytes) const {
+    Mapping mapping;
+    mapping.size = bytes;
+    bool huge = hugePages != HugePages::Off && bytes >= HugePageBytes;
+
+#ifdef _WIN32
+    // Windows has no transparent huge pages. Large pages are committed up front, so they are
+    // placed when they are allocated rather than on first touch.
+    if (huge && hugePages == HugePages::Explicit && GetLargePageMinimum() > 0 && EnableLargePages()) {
+        size_t size = RoundUp(bytes, GetLargePageMinimum());
+        mapping.base = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (mapping.base) {
+            mapping.huge = true;
+            return mapping;
+        }
+    }
+    mapping.base = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+#ifdef MAP_HUGETLB
+    // Reserved huge pages, if the administrator set some aside (vm.nr_hugepages)
+    if (huge && hugePages == HugePages::Explicit) {
+        void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            mapping.base = base;
+            mapping.huge = true;
+            return mapping;
+        }
+    }
+#endif
+
+    if (!huge) {
+        void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        mapping.base = base != MAP_FAILED ? base : nullptr;
+        return mapping;
+    }
+
+    // Transparent huge pages only back 2 MB aligned ranges: map one huge page extra, then trim
+    // the ends so the buffer starts on a boundary
+    void* raw = mmap(nullptr, bytes + HugePageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return mapping;
+    }
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = RoundUp(start, HugePageBytes);
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    if (start + HugePageBytes > aligned) {
+        munmap(reinterpret_cast<void*>(aligned + bytes), start + HugePageBytes - aligned);
+    }
+
+    mapping.base = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+    mapping.huge = madvise(mapping.base, bytes, MADV_HUGEPAGE) == 0;
+#endif
+#endif
+    return mapping;
+}
+
+// Return a mapping to the OS
+void BoardArena::Unmap(const Mapping& mapping) {
+#ifdef _WIN32
+    VirtualFree(mapping.base, 0, MEM_RELEASE);
+#else
+    munmap(mapping.base, mapping.size);
+#endif
+}
+
+// Bytes of a buffer resident on each NUMA node, false if the OS can't tell
+bool BoardArena::GetPlacement(const void* block, size_t bytes, std::vector<size_t>& bytesPerNode) {
+    bytesPerNode.clear();
+    if (bytes == 0) return true;
+
+    size_t page = PageSize();
+    uintptr_t first = reinterpret_cast<uintptr_t>(block) / page * page;
+    uintptr_t end = reinterpret_cast<uintptr_t>(block) + bytes;
+    const size_t batch = 1024;                        // Pages asked about per call
+
+    auto count = [&](int node) {
+        if (node < 0) return;                         // Not resident
+        if (static_cast<size_t>(node) >= bytesPerNode.size()) {
+            bytesPerNode.resize(node + 1, 0);
+        }
+        bytesPerNode[node] += page;
+    };
+
+#if defined(_WIN32)
+    std::vector<PSAPI_WORKING_SET_EX_INFORMATION> info(batch);
+    for (uintptr_t address = first; address < end; ) {
+        size_t pages = 0;
+        for (; pages < batch && address < end; ++pages, address += page) {
+            info[pages].VirtualAddress = reinterpret_cast<void*>(address);
+        }
+        if (!QueryWorkingSetEx(GetCurrentProcess(), info.data(), static_cast<DWORD>(pages * sizeof(info[0])))) {
+            return false;
+        }
+        for (size_t i = 0; i < pages; ++i) {
+            count(info[i].VirtualAttributes.Valid ? static_cast<int>(info[i].VirtualAttributes.Node) : -1);
+        }
+    }
+    return true;
+#elif defined(__linux__) && defined(SYS_move_pages)
+    // move_pages with no target nodes only reports where each page is
+    std::vector<void*> addresses(batch);
+    std::vector<int> status(batch);
+    for (uintptr_t address = first; address < end; ) {
+        size_t pages = 0;
+        for (; pages < batch && address < end; ++pages, address += page) {
+            addresses[pages] = reinterpret_cast<void*>(address);
+        }
+        if (syscall(SYS_move_pages, 0, pages, addresses.data(), nullptr, status.data(), 0) != 0) {
+            return false;
+        }
+        for (size_t i = 0; i < pages; ++i) {
+            count(status[i]);
+        }
+    }
+    return true;
+#else
+    (void)first;
+    (void)end;
+    (void)count;
+    return false;
+#endif
+}
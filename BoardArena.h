@@ -0,0 +1,121 @@
+#ifndef BOARDARENA_H
+#define BOARDARENA_H
+
+#include <cstddef>  // size_t
+#include <map>      // Live blocks by address
+#include <mutex>    // Boards are allocated from any thread
+#include <new>      // std::bad_alloc / placement new
+#include <string>
+#include <utility>  // std::forward
+#include <vector>
+
+// How big board buffers ask the OS for huge pages
+enum class HugePages {
+    Off = 0,                                          // Ordinary pages
+    Transparent,                                      // 2 MB aligned and advised for transparent huge pages (Linux)
+    Explicit                                          // Reserved huge pages (MAP_HUGETLB / MEM_LARGE_PAGES), else Transparent
+};
+
+const int HugePagesCount = 3;
+
+const char* GetHugePagesName(HugePages mode);         // Name shown by the CLI
+bool ParseHugePages(const std::string& name, HugePages& mode);  // Inverse of GetHugePagesName (case-insensitive)
+
+// What the arena has done so far
+struct ArenaStats {
+    long long acquired = 0;                           // Buffers handed out
+    long long reused = 0;                             // ... of which came back from an earlier release
+    size_t mappedBytes = 0;                           // Bytes mapped from the OS, in use or cached
+    size_t cachedBytes = 0;                           // Released bytes kept for reuse
+    size_t hugePageBytes = 0;                         // Mapped bytes on huge pages (or advised to be, for Transparent)
+};
+
+// Process-wide source of large board buffers. Memory comes straight from the OS in whole
+// pages, optionally huge ones, and is returned untouched, so the thread that first writes a
+// page decides which NUMA node it lands on. Released buffers are kept and handed out again for
+// the next request of the same size, which keeps a board's sandbox, or a board recreated at the
+// same size, on pages that are already placed and mapped.
+class BoardArena {
+public:
+    static const size_t MinimumBytes = 64 * 1024;     // Smaller buffers are left to the ordinary heap
+
+    static BoardArena& Get();                         // The arena shared by every board (never destroyed)
+
+    void SetHugePages(HugePages mode);                // Applies to buffers mapped from now on
+    HugePages GetHugePages() const;
+    void SetCacheLimit(size_t bytes);                 // Most released bytes kept for reuse
+
+    void* Acquire(size_t bytes);                      // Returns nullptr if the OS is out of memory
+    void Release(void* block);                        // Give back a buffer from Acquire
+    ArenaStats GetStats() const;
+
+    // Bytes of a buffer resident on each NUMA node (index = node), false if the OS can't tell.
+    // Pages that were never touched aren't resident anywhere and aren't counted.
+    static bool GetPlacement(const void* block, size_t bytes, std::vector<size_t>& bytesPerNode);
+
+private:
+    struct Mapping {
+        void* base = nullptr;                         // Start of the OS mapping (and of the buffer)
+        size_t size = 0;                              // Length of the mapping
+        bool huge = false;                            // On huge pages, or advised to be
+    };
+
+    mutable std::mutex mutex;
+    HugePages hugePages = HugePages::Transparent;
+    size_t cacheLimit = 1ULL << 30;
+    std::map<void*, Mapping> live;                    // Buffers handed out, by address
+    std::vector<Mapping> cached;                      // Released buffers, oldest first
+    ArenaStats stats;
+
+    BoardArena() {}
+
+    Mapping Map(size_t bytes) const;                  // Ask the OS for a new mapping
+    static void Unmap(const Mapping& mapping);
+};
+
+// Standard allocator over the board arena. Default-constructed elements are left
+// uninitialized, so resizing a vector doesn't touch its pages; the owner clears them
+// from the threads that will use them.
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator() {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        size_t bytes = count * sizeof(T);
+        if (bytes < BoardArena::MinimumBytes) {
+            return static_cast<T*>(::operator new(bytes));
+        }
+
+        void* block = BoardArena::Get().Acquire(bytes);
+        if (!block) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(block);
+    }
+
+    void deallocate(T* block, size_t count) {
+        if (count * sizeof(T) < BoardArena::MinimumBytes) {
+            ::operator delete(block);
+        }
+        else {
+            BoardArena::Get().Release(block);
+        }
+    }
+
+    template <typename U>
+    void construct(U* element) { ::new (static_cast<void*>(element)) U; }
+    template <typename U, typename... Args>
+    void construct(U* element, Args&&... args) { ::new (static_cast<void*>(element)) U(std::forward<Args>(args)...); }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return false; }
+
+#endif // BOARDARENA_H
@@ -0,0 +1,182 @@
+#include "BoardBatch.h"
+#include "BitKernel.h"
+#include <array>
+#include <cstdlib>    // srand / rand, as used by the GUI's Randomize Grid
+
+// Allocate the three generations and work out which board cell every ghost cell stands for
+BoardBatch::BoardBatch(int width, int height, Topology topology)
+    : width(width), height(height), pitch(width + 2) {
+    cells.assign(static_cast<size_t>(width + 2) * (height + 2), 0);
+    previous.assign(cells.size(), 0);
+    older.assign(cells.size(), 0);
+
+    auto map = [&](int row, int col) {
+        int sourceRow = row, sourceCol = col;
+        if (MapCell(sourceRow, sourceCol, width, height, topology)) {
+            ghostSources.push_back(std::make_pair(Index(row, col), Index(sourceRow, sourceCol)));
+        }
+    };
+
+    for (int col = -1; col <= width; ++col) {
+        map(-1, col);
+        map(height, col);
+    }
+    for (int row = 0; row < height; ++row) {
+        map(row, -1);
+        map(row, width);
+    }
+}
+
+// Kill every cell of one board and forget its history
+void BoardBatch::ClearLane(int lane) {
+    uint64_t keep = ~(1ULL << lane);
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            cells[Index(row, col)] &= keep;
+        }
+    }
+
+    stepped &= keep;
+    extinct &= keep;
+    still &= keep;
+    oscillating &= keep;
+}
+
+// Count living cells of one board
+long long BoardBatch::Population(int lane) const {
+    long long livingCells = 0;
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            livingCells += GetCell(lane, row, col);
+        }
+    }
+    return livingCells;
+}
+
+// Advance every board one generation
+void BoardBatch::Step() {
+    for (const auto& ghost : ghostSources) {
+        cells[ghost.first] = cells[ghost.second];
+    }
+
+    // Lanes with any living cell, any cell different from the current generation, and any
+    // cell different from the generation before it
+    uint64_t alive = 0, changed = 0, changedSincePrevious = 0;
+
+    for (int row = 0; row < height; ++row) {
+        const uint64_t* above = &cells[Index(row - 1, 0)];
+        const uint64_t* center = &cells[Index(row, 0)];
+        const uint64_t* below = &cells[Index(row + 1, 0)];
+        const uint64_t* before = &previous[Index(row, 0)];
+        uint64_t* next = &older[Index(row, 0)];  // Two generations back, no longer needed
+
+        for (int col = 0; col < width; ++col) {
+            uint64_t cell = ApplyRule(
+                above[col - 1], above[col], above[col + 1],
+                center[col - 1], center[col + 1],
+                below[col - 1], below[col], below[col + 1],
+                center[col]);
+
+            alive |= cell;
+            changed |= cell ^ center[col];
+            changedSincePrevious |= cell ^ before[col];
+            next[col] = cell;
+        }
+    }
+
+    // `older` now holds the new generation
+    cells.swap(older);      // cells = new, older = the generation just stepped from
+    previous.swap(older);   // previous = the generation just stepped from, older = the one before it
+
+    extinct = ~alive;
+    still = alive & ~changed;
+    oscillating = alive & changed & ~changedSincePrevious & stepped;
+    stepped = ~0ULL;
+}
+
+// Name of a sweep outcome for reports
+const char* GetSweepOutcomeName(SweepOutcome outcome) {
+    switch (outcome) {
+    case SweepOutcome::Extinct: return "Extinct";
+    case SweepOutcome::Still: return "Still";
+    case SweepOutcome::Oscillating: return "Oscillating";
+    case SweepOutcome::Running:
+    default: return "Running";
+    }
+}
+
+// Run the sweep, one result per seed in seed order
+long long SweepSeeds(const SweepOptions& options, std::vector<SweepResult>& results) {
+    results.assign(options.seeds, SweepResult());
+
+    BoardBatch batch(options.width, options.height, options.topology);
+    std::array<int, BoardBatch::Lanes> laneSeed;     // Index into results of the seed in each lane, -1 if idle
+    std::array<int, BoardBatch::Lanes> laneGenerations;
+    int nextSeed = 0;
+    uint64_t active = 0;                              // Lanes holding a seed that hasn't finished
+
+    // Put the next seed into a lane, filled exactly like MainWindow::RandomizeGrid
+    auto load = [&](int lane) {
+        batch.ClearLane(lane);
+        laneGenerations[lane] = 0;
+
+        if (nextSeed >= options.seeds) {
+            laneSeed[lane] = -1;
+            active &= ~(1ULL << lane);
+            return;
+        }
+
+        laneSeed[lane] = nextSeed;
+        results[nextSeed].seed = options.firstSeed + nextSeed;
+        srand(options.firstSeed + nextSeed);
+        for (int row = 0; row < options.height; ++row) {
+            for (int col = 0; col < options.width; ++col) {
+                batch.SetCell(lane, row, col, (rand() % 100) < options.density);
+            }
+        }
+        active |= 1ULL << lane;
+        ++nextSeed;
+    };
+
+    for (int lane = 0; lane < BoardBatch::Lanes; ++lane) {
+        load(lane);
+    }
+
+    long long generationsStepped = 0;
+    while (active != 0) {
+        batch.Step();
+        generationsStepped += CountBits(active);
+
+        uint64_t extinct = batch.GetExtinctLanes();
+        uint64_t still = batch.GetStillLanes();
+        uint64_t settled = batch.GetSettledLanes();
+
+        for (int lane = 0; lane < BoardBatch::Lanes; ++lane) {
+            uint64_t bit = 1ULL << lane;
+            if ((active & bit) == 0) continue;
+
+            ++laneGenerations[lane];
+            if ((settled & bit) == 0 && laneGenerations[lane] < options.maxGenerations) continue;
+
+            SweepResult& result = results[laneSeed[lane]];
+            result.generations = laneGenerations[lane];
+            result.population = batch.Population(lane);
+            if (extinct & bit) {
+                result.outcome = SweepOutcome::Extinct;
+            }
+            else if (still & bit) {
+                result.outcome = SweepOutcome::Still;
+            }
+            else if (settled & bit) {
+                result.outcome = SweepOutcome::Oscillating;
+            }
+            else {
+                result.outcome = SweepOutcome::Running;
+            }
+
+            load(lane);  // Refill the lane with the next seed, or leave it idle
+        }
+    }
+
+    return generationsStepped;
+}
@@ -0,0 +1,100 @@
+#ifndef BOARDBATCH_H
+#define BOARDBATCH_H
+
+#include "Topology.h"  // How the board edges are joined
+#include <cstddef>     // size_t
+#include <cstdint>     // Fixed-width integer types for lane words
+#include <utility>     // std::pair
+#include <vector>      // STL vector for the cell words
+
+// 64 independent boards of the same size stepped together. The boards are transposed so that
+// every cell is one 64-bit word and bit k of it is that cell on board (lane) k; the rules are
+// then applied to all 64 boards with the same word operations the bit-parallel engine uses for
+// 64 neighboring cells. Made for seed sweeps over many small boards, where a single board only
+// fills a fraction of each word.
+//
+// After every step the batch reports which lanes died out, stopped changing, or fell into a
+// period 2 oscillation, so a finished lane can be loaded with a new board and keep running.
+class BoardBatch {
+public:
+    static const int Lanes = 64;                      // Boards per batch, one per bit of a word
+
+    BoardBatch(int width, int height, Topology topology);
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+    bool GetCell(int lane, int row, int col) const { return (cells[Index(row, col)] >> lane) & 1; }
+    void SetCell(int lane, int row, int col, bool alive) {
+        uint64_t& word = cells[Index(row, col)];
+        uint64_t bit = 1ULL << lane;
+        word = alive ? (word | bit) : (word & ~bit);
+    }
+    void ClearLane(int lane);                         // Kill every cell of one board and forget its history
+    long long Population(int lane) const;             // Count living cells of one board
+
+    void Step();                                      // Advance every board one generation
+
+    // Lanes classified by the last Step. A lane only counts as oscillating once it has been
+    // stepped twice since it was loaded.
+    uint64_t GetExtinctLanes() const { return extinct; }          // No living cells left
+    uint64_t GetStillLanes() const { return still; }              // Alive, and the same as the generation before
+    uint64_t GetOscillatingLanes() const { return oscillating; }  // Back to the board of two generations ago
+    uint64_t GetSettledLanes() const { return extinct | still | oscillating; }
+
+private:
+    int width = 0;                                    // Board width in cells
+    int height = 0;                                   // Board height in cells
+    int pitch = 0;                                    // Words per row including the two ghost cells
+
+    std::vector<uint64_t> cells;                      // Current generation with a ghost border
+    std::vector<uint64_t> previous;                   // Generation before, for oscillation checks
+    std::vector<uint64_t> older;                      // Two generations back; overwritten by the next one
+
+    // Ghost cells that stand for a board cell under the topology, as (ghost, source) indices.
+    // Ghost cells off a finite edge aren't listed and stay dead in all three buffers.
+    std::vector<std::pair<size_t, size_t>> ghostSources;
+
+    uint64_t stepped = 0;                             // Lanes stepped since they were loaded, so `previous` is theirs
+    uint64_t extinct = 0;
+    uint64_t still = 0;
+    uint64_t oscillating = 0;
+
+    size_t Index(int row, int col) const { return static_cast<size_t>(row + 1) * pitch + col + 1; }
+};
+
+// Seed sweep: every seed fills a board the same way the GUI's Randomize Grid does, and is run
+// until it settles or hits the generation limit. Seeds are fed through a BoardBatch, each
+// finished lane being refilled with the next seed.
+struct SweepOptions {
+    int width = 15;                                   // Board size (the GUI's default grid)
+    int height = 15;
+    Topology topology = Topology::Finite;
+    int firstSeed = 0;                                // Seeds firstSeed .. firstSeed + seeds - 1
+    int seeds = 1000;
+    int density = 45;                                 // Percent chance of a cell starting alive
+    int maxGenerations = 1000;                        // Boards still changing after this many are reported Running
+};
+
+enum class SweepOutcome {
+    Extinct,                                          // Every cell died
+    Still,                                            // Nothing changes any more
+    Oscillating,                                      // Alternates between two boards
+    Running                                           // Still changing at the generation limit
+};
+
+const int SweepOutcomeCount = 4;
+
+const char* GetSweepOutcomeName(SweepOutcome outcome);
+
+struct SweepResult {
+    int seed = 0;
+    SweepOutcome outcome = SweepOutcome::Running;
+    int generations = 0;                              // Generations stepped until the outcome was seen
+    long long population = 0;                         // Living cells at that point
+};
+
+// Run the sweep, one result per seed in seed order. Returns the total number of board generations stepped.
+long long SweepSeeds(const SweepOptions& options, std::vector<SweepResult>& results);
+
+#endif // BOARDBATCH_H
@@ -0,0 +1,168 @@
+#include "ChangeListEngine.h"
+
+// The summary index reads tiles by packing the alive bits of each row
+ChangeListEngine::ChangeListEngine()
+    : summary([this](int tileRow, int tileCol, uint64_t* words) {
+          int first = tileCol * SummaryIndex::TileSize;
+          int count = width - first < SummaryIndex::TileSize ? width - first : SummaryIndex::TileSize;
+          for (int i = 0; i < SummaryIndex::TileSize; ++i) {
+              int row = tileRow * SummaryIndex::TileSize + i;
+              words[i] = 0;
+              if (row >= height) continue;
+
+              const unsigned char* cell = &cells[Index(row, first)];
+              for (int j = 0; j < count; ++j) {
+                  words[i] |= static_cast<uint64_t>(cell[j] & AliveBit) << j;
+              }
+          }
+          return true;
+      }) {
+}
+
+// Change the board size, killing every cell
+void ChangeListEngine::Resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    cells.assign(static_cast<size_t>(width) * height, 0);
+
+    // Cells on the edge have neighbors that wrap or fall off the board
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            if (row == 0 || row == height - 1 || col == 0 || col == width - 1) {
+                cells[Index(row, col)] = EdgeBit;
+            }
+        }
+    }
+
+    changes.clear();
+    population = 0;
+    summary.Resize(width, height);
+}
+
+// Kill every cell
+void ChangeListEngine::Clear() {
+    for (unsigned char& cell : cells) {
+        cell &= EdgeBit;
+    }
+    changes.clear();
+    population = 0;
+    summary.Resize(width, height);
+}
+
+// Which cells are neighbors depends on the topology, so every count has to be rebuilt
+void ChangeListEngine::SetTopology(Topology newTopology) {
+    if (newTopology == topology) return;
+    topology = newTopology;
+
+    for (unsigned char& cell : cells) {
+        cell &= AliveBit | EdgeBit;
+    }
+    changes.clear();
+
+    for (size_t index = 0; index < cells.size(); ++index) {
+        if (cells[index] & AliveBit) {
+            ForEachNeighbor(index, [this](size_t neighbor) { cells[neighbor] += CountOne; });
+            MarkChanged(index);  // The cells around it may now be born or die
+        }
+    }
+}
+
+// Edit one cell; it and its neighbors are evaluated in the next generation
+void ChangeListEngine::SetCell(int row, int col, bool alive) {
+    size_t index = Index(row, col);
+    if (((cells[index] & AliveBit) != 0) != alive) {
+        Flip(index);
+        MarkChanged(index);
+    }
+}
+
+// Advance the board by a number of generations
+void ChangeListEngine::Step(int generations) {
+    for (int i = 0; i < generations && !changes.empty(); ++i) {
+        NextGeneration();
+    }
+}
+
+// Call visit(neighbor index) for all eight neighbors. Inside the board they are fixed offsets;
+// on the edge they are mapped through the topology and may repeat (or be the cell itself) on
+// boards one or two cells across, exactly like the ghost border of the other engines.
+template <typename Visit>
+void ChangeListEngine::ForEachNeighbor(size_t index, Visit visit) const {
+    if ((cells[index] & EdgeBit) == 0) {
+        size_t above = index - width, below = index + width;
+        visit(above - 1); visit(above); visit(above + 1);
+        visit(index - 1); visit(index + 1);
+        visit(below - 1); visit(below); visit(below + 1);
+        return;
+    }
+
+    int row = static_cast<int>(index / width);
+    int col = static_cast<int>(index % width);
+    for (int rowOffset = -1; rowOffset <= 1; ++rowOffset) {
+        for (int colOffset = -1; colOffset <= 1; ++colOffset) {
+            if (rowOffset == 0 && colOffset == 0) continue;
+
+            int neighborRow = row + rowOffset, neighborCol = col + colOffset;
+            if (MapCell(neighborRow, neighborCol, width, height, topology)) {
+                visit(Index(neighborRow, neighborCol));
+            }
+        }
+    }
+}
+
+// Toggle a cell and update its neighbors' counts
+void ChangeListEngine::Flip(size_t index) {
+    cells[index] ^= AliveBit;
+    summary.Invalidate(static_cast<int>(index / width), static_cast<int>(index % width));
+
+    if (cells[index] & AliveBit) {
+        ++population;
+        ForEachNeighbor(index, [this](size_t neighbor) { cells[neighbor] += CountOne; });
+    }
+    else {
+        --population;
+        ForEachNeighbor(index, [this](size_t neighbor) { cells[neighbor] -= CountOne; });
+    }
+}
+
+// Add a cell to the change list once
+void ChangeListEngine::MarkChanged(size_t index) {
+    if ((cells[index] & ChangedBit) == 0) {
+        cells[index] |= ChangedBit;
+        changes.push_back(index);
+    }
+}
+
+// Function to advance to the next generation of cells (game logic).
+// Only a cell that changed, or has a neighbor that changed, can change now.
+void ChangeListEngine::NextGeneration() {
+    candidates.clear();
+    auto queue = [this](size_t index) {
+        if ((cells[index] & CandidateBit) == 0) {
+            cells[index] |= CandidateBit;
+            candidates.push_back(index);
+        }
+    };
+
+    for (size_t index : changes) {
+        cells[index] &= ~ChangedBit;
+        queue(index);
+        ForEachNeighbor(index, queue);
+    }
+    changes.clear();
+
+    // Decide every candidate from the current counts before any of them change
+    for (size_t index : candidates) {
+        unsigned char cell = cells[index] &= ~CandidateBit;
+        int livingNeighbors = (cell & CountMask) >> CountShift;
+        bool alive = (cell & AliveBit) != 0;
+
+        if (alive != (livingNeighbors == 3 || (alive && livingNeighbors == 2))) {
+            MarkChanged(index);
+        }
+    }
+
+    for (size_t index : changes) {
+        Flip(index);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef CHANGELISTENGINE_H
+#define CHANGELISTENGINE_H
+
+#include "LifeEngine.h"
+#include "SummaryIndex.h"
+#include <cstddef>  // size_t
+#include <vector>
+
+// Event-driven engine for sparse boards with little activity. Every cell keeps its own living
+// neighbor count, updated whenever a neighbor is born or dies, and the engine keeps a list of
+// the cells that changed in the last generation. Only those cells and their neighbors can
+// change next, so a generation costs time proportional to the number of changes instead of
+// the board area: a few gliders on a huge empty field step as fast as on a small one, and a
+// board that has settled into still lifes costs nothing at all.
+// Region queries go through a SummaryIndex; every flip marks its tile, so a query after a step
+// only re-reads the tiles where something happened.
+class ChangeListEngine : public LifeEngine {
+public:
+    ChangeListEngine();
+    ChangeListEngine(const ChangeListEngine&) = delete;
+    ChangeListEngine& operator=(const ChangeListEngine&) = delete;
+
+    const char* GetName() const override { return "Change-list"; }
+
+    void Resize(int width, int height) override;
+    int GetWidth() const override { return width; }
+    int GetHeight() const override { return height; }
+    void SetTopology(Topology newTopology) override;  // Recounts every neighbor when the topology changes
+
+    bool GetCell(int row, int col) const override { return (cells[Index(row, col)] & AliveBit) != 0; }
+    void SetCell(int row, int col, bool alive) override;
+    void Clear() override;
+
+    void Step(int generations) override;
+    long long Population() const override { return population; }
+
+    long long CountRegion(int row, int col, int rows, int cols) const override { return summary.CountRegion(row, col, rows, cols); }
+    bool GetLiveBounds(int& top, int& left, int& bottom, int& right) const override { return summary.GetLiveBounds(top, left, bottom, right); }
+    bool FindNextLiveCell(int& row, int& col) const override { return summary.FindNextLiveCell(row, col); }
+
+    size_t GetChangeCount() const { return changes.size(); }  // Cells that changed in the last generation
+
+private:
+    // Each cell is one byte: alive bit, neighbor count, and bookkeeping flags
+    static const unsigned char AliveBit = 0x01;
+    static const int CountShift = 1;                  // Bits 1-4 hold the living neighbor count (0-8)
+    static const unsigned char CountOne = 1 << CountShift;
+    static const unsigned char CountMask = 0x0F << CountShift;
+    static const unsigned char CandidateBit = 0x20;   // Already queued for evaluation this generation
+    static const unsigned char EdgeBit = 0x40;        // On the board edge: neighbors go through the topology
+    static const unsigned char ChangedBit = 0x80;     // Already in the change list
+
+    std::vector<unsigned char> cells;                 // One byte per cell, row after row, no ghost border
+    std::vector<size_t> changes;                      // Cells that changed in the last generation (or were edited)
+    std::vector<size_t> candidates;                   // Scratch list of cells to evaluate
+    int width = 0;
+    int height = 0;
+    long long population = 0;                         // Living cells, kept up to date on every change
+    Topology topology = Topology::Finite;             // How the board edges are joined
+    mutable SummaryIndex summary;                     // Tiles are marked by Flip, re-read by the queries
+
+    size_t Index(int row, int col) const { return static_cast<size_t>(row) * width + col; }
+
+    template <typename Visit>
+    void ForEachNeighbor(size_t index, Visit visit) const;  // Call visit(neighbor index) for all eight neighbors
+    void Flip(size_t index);                          // Toggle a cell and update its neighbors' counts
+    void MarkChanged(size_t index);                   // Add a cell to the change list once
+    void NextGeneration();                            // Evaluate the changed cells and their neighbors
+};
+
+#endif // CHANGELISTENGINE_H
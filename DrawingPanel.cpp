@@ -2,17 +2,22 @@
 #include "wx/graphics.h"
 #include "wx/dcbuffer.h"
 #include "MainWindow.h"  // Include to access MainWindow and its methods
+#include <algorithm>     // std::min / std::max for clamping the repaint area
+#include <cstdlib>       // std::abs for walking paint strokes
 
 // Event table for handling events in DrawingPanel
 wxBEGIN_EVENT_TABLE(DrawingPanel, wxPanel)
 EVT_PAINT(DrawingPanel::OnPaint)      // Paint event
-EVT_LEFT_UP(DrawingPanel::OnMouseUp)  // Mouse click event
+EVT_LEFT_DOWN(DrawingPanel::OnMouseDown)  // Start painting cells
+EVT_MOTION(DrawingPanel::OnMouseMove)     // Keep painting while dragging
+EVT_LEFT_UP(DrawingPanel::OnMouseUp)      // Finish painting
+EVT_MOUSE_CAPTURE_LOST(DrawingPanel::OnMouseCaptureLost)  // Finish painting if the mouse capture is taken away
 EVT_SIZE(DrawingPanel::OnResize)      // Window resize event
 wxEND_EVENT_TABLE()
 
 // Constructor for DrawingPanel, linking it with the game board and settings
-DrawingPanel::DrawingPanel(wxWindow* parent, std::vector<std::vector<bool>>& gameBoardRef)
-    : wxPanel(parent, wxID_ANY), gameBoard(gameBoardRef), settings(nullptr) {
+DrawingPanel::DrawingPanel(wxWindow* parent, std::vector<std::vector<bool>>& gameBoardRef, EditQueue& editQueueRef)
+    : wxPanel(parent, wxID_ANY), gameBoard(gameBoardRef), editQueue(editQueueRef), settings(nullptr) {
     this->SetBackgroundStyle(wxBG_STYLE_PAINT);  // Set background style to avoid flickering
 }
 
@@ -35,15 +40,26 @@ void DrawingPanel::OnPaint(wxPaintEvent& evt) {
     wxSize panelSize = GetClientSize();  // Get the size of the drawing panel
 
     // Calculate the width and height of each cell based on the grid size and panel size
-    int cellWidth = panelSize.GetWidth() / settings->gridSize;
-    int cellHeight = panelSize.GetHeight() / settings->gridSize;
+    int cellWidth = panelSize.GetWidth() / settings->gridWidth;
+    int cellHeight = panelSize.GetHeight() / settings->gridHeight;
+
+    // Only walk the cells inside the damaged area, so single-cell refreshes stay cheap
+    int rowBegin = 0, rowEnd = settings->gridHeight - 1;
+    int colBegin = 0, colEnd = settings->gridWidth - 1;
+    if (cellWidth > 0 && cellHeight > 0) {
+        wxRect updateBox = GetUpdateRegion().GetBox();
+        rowBegin = std::max(0, updateBox.GetTop() / cellHeight);
+        rowEnd = std::min(settings->gridHeight - 1, updateBox.GetBottom() / cellHeight);
+        colBegin = std::max(0, updateBox.GetLeft() / cellWidth);
+        colEnd = std::min(settings->gridWidth - 1, updateBox.GetRight() / cellWidth);
+    }
 
     // Set the pen color for grid lines (default is black)
     context->SetPen(*wxBLACK);
 
     // Loop through the game board and draw cells (alive/dead) and grid lines
-    for (int row = 0; row < settings->gridSize; ++row) {
-        for (int col = 0; col < settings->gridSize; ++col) {
+    for (int row = rowBegin; row <= rowEnd; ++row) {
+        for (int col = colBegin; col <= colEnd; ++col) {
             int x = col * cellWidth;
             int y = row * cellHeight;
 
@@ -68,10 +84,16 @@ void DrawingPanel::OnPaint(wxPaintEvent& evt) {
         // Access MainWindow to retrieve generationCount and livingCellsCount
         MainWindow* parent = static_cast<MainWindow*>(GetParent());
 
+        // Where the living cells are, from the engine's summary index rather than a board scan
+        int top, left, bottom, right;
+        wxString liveArea = parent->GetLiveBounds(top, left, bottom, right)
+            ? wxString::Format("rows %d-%d, columns %d-%d", top, bottom, left, right)
+            : wxString("none");
+
         wxString hudText = wxString::Format(
-            "Generations: %d\nLiving Cells: %d\nBoundary: %s\nGrid Size: %d x %d",
+            "Generations: %d\nLiving Cells: %d\nBoundary: %s\nGrid Size: %d x %d\nLive Area: %s",
             parent->GetGenerationCount(), parent->GetLivingCellsCount(),
-            settings->isToroidal ? "Toroidal" : "Finite", settings->gridSize, settings->gridSize
+            GetTopologyName(settings->GetTopology()), settings->gridWidth, settings->gridHeight, liveArea
         );
 
         double textWidth, textHeight;
@@ -79,6 +101,11 @@ void DrawingPanel::OnPaint(wxPaintEvent& evt) {
 
         // Draw the HUD text in the bottom left corner of the panel
         context->DrawText(hudText, 10, panelSize.GetHeight() - textHeight - 10);
+
+        // Remember where the HUD is so cell edits can repaint just that area. Edits can make
+        // the text wider, so the box runs the full width of the panel.
+        int hudTop = static_cast<int>(panelSize.GetHeight() - textHeight - 10);
+        hudBox = wxRect(0, hudTop, panelSize.GetWidth(), panelSize.GetHeight() - hudTop);
     }
 
     delete context;  // Clean up the graphics context after use
@@ -90,28 +117,142 @@ void DrawingPanel::OnResize(wxSizeEvent& event) {
     event.Skip();  // Allow default handling of the resize event
 }
 
-// Mouse click event handler: toggles the state of a clicked cell (alive/dead)
-void DrawingPanel::OnMouseUp(wxMouseEvent& event) {
-    int mouseX = event.GetX();  // Get X-coordinate of the mouse click
-    int mouseY = event.GetY();  // Get Y-coordinate of the mouse click
+// Repaint only the rectangle covered by a single cell
+void DrawingPanel::RefreshCell(int row, int col) {
+    wxSize panelSize = GetClientSize();
+    int cellWidth = panelSize.GetWidth() / settings->gridWidth;
+    int cellHeight = panelSize.GetHeight() / settings->gridHeight;
 
+    RefreshRect(wxRect(col * cellWidth, row * cellHeight, cellWidth, cellHeight), false);
+}
+
+// Repaint the HUD after cell edits change its counts; the cells under it are redrawn too,
+// so the text is never clipped to a single cell
+void DrawingPanel::RefreshHud() {
+    if (settings->showHUD && !hudBox.IsEmpty()) {
+        RefreshRect(hudBox, false);
+    }
+}
+
+// Map a position on the panel to the cell underneath it, returns false if it is off the board
+bool DrawingPanel::CellFromPoint(const wxPoint& point, int& row, int& col) const {
     wxSize panelSize = GetClientSize();  // Get the size of the panel
 
     // Calculate which cell was clicked based on the mouse position
-    int cellWidth = panelSize.GetWidth() / settings->gridSize;
-    int cellHeight = panelSize.GetHeight() / settings->gridSize;
+    int cellWidth = panelSize.GetWidth() / settings->gridWidth;
+    int cellHeight = panelSize.GetHeight() / settings->gridHeight;
 
     // Ensure valid cell size to prevent division by zero errors
-    if (cellWidth == 0 || cellHeight == 0) return;
+    if (cellWidth == 0 || cellHeight == 0) return false;
+    if (point.x < 0 || point.y < 0) return false;
 
     // Calculate the row and column of the clicked cell
-    int col = mouseX / cellWidth;
-    int row = mouseY / cellHeight;
+    col = point.x / cellWidth;
+    row = point.y / cellHeight;
 
     // Ensure the clicked cell is within the grid bounds
-    if (row >= 0 && row < settings->gridSize && col >= 0 && col < settings->gridSize) {
-        gameBoard[row][col] = !gameBoard[row][col];  // Toggle the cell's state (alive or dead)
+    return row < settings->gridHeight && col < settings->gridWidth;
+}
+
+// Hand a single cell edit to the simulation, returns false if the queue is full.
+// The panel is only the producer: it never drains the queue itself, it retries later.
+bool DrawingPanel::QueueEdit(int row, int col) {
+    CellEdit edit;
+    edit.row = row;
+    edit.col = col;
+    edit.alive = paintValue;
+    return editQueue.Push(edit);
+}
+
+// Queue every cell on the line between the last painted cell and (toRow, toCol),
+// so fast drags don't leave gaps between mouse motion events. If the queue fills up the
+// stroke stops at the last queued cell and the next motion event carries on from there.
+void DrawingPanel::PaintLine(int toRow, int toCol) {
+    if (!lastQueued) {
+        if (!QueueEdit(lastRow, lastCol)) return;  // The stroke's first cell is still waiting
+        lastQueued = true;
+    }
+
+    int row = lastRow;
+    int col = lastCol;
+    int deltaRow = std::abs(toRow - row), stepRow = row < toRow ? 1 : -1;
+    int deltaCol = std::abs(toCol - col), stepCol = col < toCol ? 1 : -1;
+    int error = deltaCol - deltaRow;
+
+    while (row != toRow || col != toCol) {
+        int error2 = error * 2;
+        if (error2 > -deltaRow) { error -= deltaRow; col += stepCol; }
+        if (error2 < deltaCol) { error += deltaCol; row += stepRow; }
+        if (!QueueEdit(row, col)) return;  // Full: retry from (lastRow, lastCol) next time
+
+        lastRow = row;
+        lastCol = col;
     }
+}
+
+// Mouse down event handler: toggles the clicked cell and starts a paint stroke with its new state
+void DrawingPanel::OnMouseDown(wxMouseEvent& event) {
+    int row, col;
+    if (!CellFromPoint(event.GetPosition(), row, col)) return;
+
+    // The whole stroke paints the toggled state of the first cell, counting an edit still in the queue
+    bool alive = gameBoard[row][col];
+    editQueue.FindPending(row, col, alive);
+    paintValue = !alive;
+    isPainting = true;
+    lastRow = row;
+    lastCol = col;
+    CaptureMouse();  // Keep receiving motion events even if the cursor leaves the panel
+
+    lastQueued = QueueEdit(row, col);  // If the queue is full, the next motion event retries
+
+    MainWindow* parent = static_cast<MainWindow*>(GetParent());
+    if (!parent->IsRunning()) {
+        parent->ApplyPendingEdits(true);  // No generation is coming, so apply right away
+    }
+}
+
+// Mouse move event handler: paints every cell the cursor passes over while the button is down
+void DrawingPanel::OnMouseMove(wxMouseEvent& event) {
+    if (!isPainting || !event.LeftIsDown()) return;
+
+    int row, col;
+    if (!CellFromPoint(event.GetPosition(), row, col)) return;
+    if (row == lastRow && col == lastCol && lastQueued) return;  // Still inside the same cell
+
+    PaintLine(row, col);
+
+    MainWindow* parent = static_cast<MainWindow*>(GetParent());
+    if (!parent->IsRunning()) {
+        parent->ApplyPendingEdits(true);
+    }
+}
+
+// Mouse up event handler: ends the current paint stroke. A cell the queue was too full to take
+// is not dropped: the pending edits are applied to make room and it is queued again.
+void DrawingPanel::OnMouseUp(wxMouseEvent& event) {
+    if (!isPainting) return;
+
+    isPainting = false;
+    if (HasCapture()) {
+        ReleaseMouse();
+    }
+
+    if (lastQueued) return;
+
+    MainWindow* parent = static_cast<MainWindow*>(GetParent());
+    if (!QueueEdit(lastRow, lastCol)) {
+        parent->ApplyPendingEdits(true);
+        QueueEdit(lastRow, lastCol);
+    }
+    lastQueued = true;
+
+    if (!parent->IsRunning()) {
+        parent->ApplyPendingEdits(true);
+    }
+}
 
-    Refresh();  // Redraw the panel to reflect the updated cell state
+// Capture lost event handler: ends the paint stroke without releasing (the capture is already gone)
+void DrawingPanel::OnMouseCaptureLost(wxMouseCaptureLostEvent& event) {
+    isPainting = false;
 }
@@ -3,22 +3,41 @@
 
 #include "wx/wx.h"
 #include "Settings.h"  // Make sure Settings.h is included
+#include "EditQueue.h" // Queue that carries painted cells over to the simulation
 #include <vector>
 
 class DrawingPanel : public wxPanel {
 public:
-    DrawingPanel(wxWindow* parent, std::vector<std::vector<bool>>& gameBoardRef);
+    DrawingPanel(wxWindow* parent, std::vector<std::vector<bool>>& gameBoardRef, EditQueue& editQueueRef);
     ~DrawingPanel();
 
     void SetSettings(Settings* settingsPtr);  // Setter for settings pointer
     void OnPaint(wxPaintEvent& evt);
     void OnResize(wxSizeEvent& event);
+    void OnMouseDown(wxMouseEvent& event);
+    void OnMouseMove(wxMouseEvent& event);
     void OnMouseUp(wxMouseEvent& event);
+    void OnMouseCaptureLost(wxMouseCaptureLostEvent& event);
+
+    void RefreshCell(int row, int col);  // Repaint only the rectangle covered by one cell
+    void RefreshHud();  // Repaint the HUD (and the cells under it) if it is shown
 
 private:
     std::vector<std::vector<bool>>& gameBoard;  // Reference to the game board
+    EditQueue& editQueue;  // Reference to the queue of edits waiting for the simulation
     Settings* settings = nullptr;  // Pointer to the Settings object
 
+    bool isPainting = false;  // True while the left button is held down over the board
+    bool paintValue = false;  // State painted into every cell touched by the current drag
+    int lastRow = -1;  // Last cell painted during the current drag
+    int lastCol = -1;
+    bool lastQueued = false;  // False while the queue was too full to take the edit for (lastRow, lastCol)
+    wxRect hudBox;  // Area the HUD covered in the last full paint
+
+    bool CellFromPoint(const wxPoint& point, int& row, int& col) const;  // Map a panel position to a cell
+    void PaintLine(int toRow, int toCol);  // Queue every cell between the last painted cell and (toRow, toCol)
+    bool QueueEdit(int row, int col);  // Hand a single cell edit to the simulation, false if the queue is full
+
     wxDECLARE_EVENT_TABLE();  // Declare the event table for DrawingPanel
 };
 
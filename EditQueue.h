@@ -0,0 +1,79 @@
+#ifndef EDITQUEUE_H
+#define EDITQUEUE_H
+
+#include <atomic>   // std::atomic for the lock-free read/write positions
+#include <cstddef>  // size_t
+#include <vector>   // STL vector for the ring buffer storage
+
+// A single pending change to the game board: set the cell at (row, col) alive or dead
+struct CellEdit {
+    int row = 0;
+    int col = 0;
+    bool alive = false;
+};
+
+// Bounded single-producer/single-consumer ring buffer of cell edits.
+// The drawing panel pushes edits while the user paints, and the simulation drains
+// them between generations, so neither side ever blocks the other. A producer that finds
+// the queue full must not pop to make room; it keeps the edit and pushes it again later.
+class EditQueue {
+public:
+    // Capacity is rounded up to a power of two so positions can be wrapped with a mask
+    explicit EditQueue(size_t capacity = 4096) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        buffer.resize(size);
+        mask = size - 1;
+    }
+
+    // Producer side: queue an edit, returns false if the queue is full
+    bool Push(const CellEdit& edit) {
+        size_t writePos = tail.load(std::memory_order_relaxed);
+        if (writePos - head.load(std::memory_order_acquire) > mask) {
+            return false;  // Full: the consumer has not caught up yet
+        }
+
+        buffer[writePos & mask] = edit;
+        tail.store(writePos + 1, std::memory_order_release);  // Publish the edit to the consumer
+        return true;
+    }
+
+    // Consumer side: take the oldest edit, returns false if the queue is empty
+    bool Pop(CellEdit& edit) {
+        size_t readPos = head.load(std::memory_order_relaxed);
+        if (readPos == tail.load(std::memory_order_acquire)) {
+            return false;  // Empty
+        }
+
+        edit = buffer[readPos & mask];
+        head.store(readPos + 1, std::memory_order_release);  // Hand the slot back to the producer
+        return true;
+    }
+
+    // Producer side: the state of the newest edit still waiting for (row, col), false if there is none.
+    // Only the consumer moves head, and it never writes slots, so scanning back from the tail is safe.
+    bool FindPending(int row, int col, bool& alive) const {
+        size_t readPos = head.load(std::memory_order_acquire);
+        for (size_t pos = tail.load(std::memory_order_relaxed); pos != readPos; --pos) {
+            const CellEdit& edit = buffer[(pos - 1) & mask];
+            if (edit.row == row && edit.col == col) {
+                alive = edit.alive;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True if there is nothing waiting to be applied
+    bool IsEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<CellEdit> buffer;                 // Ring buffer storage
+    size_t mask = 0;                              // buffer.size() - 1
+    alignas(64) std::atomic<size_t> head{ 0 };    // Next position to read (owned by the consumer)
+    alignas(64) std::atomic<size_t> tail{ 0 };    // Next position to write (owned by the producer)
+};
+
+#endif // EDITQUEUE_H
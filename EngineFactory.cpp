@@ -0,0 +1,193 @@
+#include "EngineFactory.h"
+#include "BitEngine.h"
+#include "BlockedStepper.h"
+#include "ChangeListEngine.h"
+#include "FixedEngine.h"
+#include "MappedEngine.h"
+#include "NaiveEngine.h"
+#include <algorithm>  // std::min / std::max
+#include <cctype>     // std::tolower
+#include <chrono>     // Timing the calibration run
+#include <map>
+#include <mutex>
+#include <tuple>      // Key of the remembered gains
+
+namespace {
+    const char* EngineKindNames[EngineKindCount] = {
+        "Automatic", "Naive", "Bit-parallel", "Cache-blocked", "Memory-mapped", "Fixed-size", "Change-list"
+    };
+
+    const long long OutOfCoreBytes = 1LL << 30;        // Packed boards bigger than this go to a backing file
+    const long long ChangeListMaxCells = 1LL << 30;    // The change-list engine keeps a byte per cell in memory
+    const double SparseDensity = 0.01;                 // Living fraction under which a board counts as sparse
+    const double BlockingMargin = 1.05;                // Blocking must beat plain stepping by this much to be picked
+    const long long CalibrationBytes = 4LL << 20;      // Packed bytes of board a calibration run steps (at least 4x the cache)
+
+    typedef std::tuple<int, int, int, int> GainKey;    // Width, height, topology, threads
+    std::mutex gainMutex;
+    std::map<GainKey, double> blockingGains;           // Calibrated or recorded gains
+
+    // Time plain and blocked stepping on a random board of the same width and edge rules.
+    // Tall boards are cut down to a few times the cache size, which is enough to show the gain.
+    double MeasureBlockingGain(int width, int height, Topology topology, int threads) {
+        BlockedStepper stepper;
+        int depth = stepper.GetDepth();
+        long long sampleBytes = std::max<long long>(CalibrationBytes, 4LL * static_cast<long long>(stepper.GetCacheBytes()));
+        long long rowBytes = (width + 63) / 64 * static_cast<long long>(sizeof(uint64_t));
+        int rows = static_cast<int>(std::min<long long>(height, std::max<long long>(sampleBytes / rowBytes, 8LL * depth)));
+
+        BitBoard start(width, rows);
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (int row = 0; row < rows; ++row) {
+            uint64_t* words = start.Row(row);
+            for (int word = 0; word < start.GetStride(); ++word) {
+                state ^= state << 13;                      // xorshift64: about half the cells alive
+                state ^= state >> 7;
+                state ^= state << 17;
+                words[word] = word == start.GetStride() - 1 ? state & start.LastWordMask() : state;
+            }
+        }
+
+        // One full pass of the blocked stepper, and as many plain generations
+        int generations = depth;
+        std::unique_ptr<BandPool> bands(threads > 1 ? new BandPool(threads) : nullptr);
+        BitBoard plain = start, sandbox;
+        auto plainStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < generations; ++i) {
+            if (bands) {
+                StepBitBoard(plain, sandbox, topology, *bands);
+            }
+            else {
+                StepBitBoard(plain, sandbox, topology);
+            }
+            plain.Swap(sandbox);
+        }
+        double plainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - plainStart).count();
+
+        BitBoard blocked = start;
+        auto blockedStart = std::chrono::steady_clock::now();
+        stepper.Step(blocked, generations, topology);
+        double blockedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - blockedStart).count();
+
+        return blockedSeconds > 0 ? plainSeconds / blockedSeconds : 1.0;
+    }
+}
+
+// Name shown in the settings dialog and CLI
+const char* GetEngineKindName(EngineKind kind) {
+    int index = static_cast<int>(kind);
+    return index >= 0 && index < EngineKindCount ? EngineKindNames[index] : "Unknown";
+}
+
+// Inverse of GetEngineKindName (case-insensitive)
+bool ParseEngineKind(const std::string& name, EngineKind& kind) {
+    for (int index = 0; index < EngineKindCount; ++index) {
+        std::string candidate = EngineKindNames[index];
+        if (candidate.size() != name.size()) continue;
+
+        bool same = true;
+        for (size_t i = 0; i < name.size() && same; ++i) {
+            same = std::tolower(static_cast<unsigned char>(name[i])) == std::tolower(static_cast<unsigned char>(candidate[i]));
+        }
+        if (same) {
+            kind = static_cast<EngineKind>(index);
+            return true;
+        }
+    }
+    return false;
+}
+
+// How much faster the cache-blocked stepper is than plain stepping, calibrated once per board shape
+double GetBlockingGain(int width, int height, Topology topology, int threads) {
+    GainKey key(width, height, static_cast<int>(topology), threads);
+    {
+        std::lock_guard<std::mutex> lock(gainMutex);
+        auto it = blockingGains.find(key);
+        if (it != blockingGains.end()) return it->second;
+    }
+
+    double gain = MeasureBlockingGain(width, height, topology, threads);
+    RecordBlockingGain(width, height, topology, threads, gain);
+    return gain;
+}
+
+// Use a gain measured elsewhere (bench) instead of calibrating
+void RecordBlockingGain(int width, int height, Topology topology, int threads, double gain) {
+    std::lock_guard<std::mutex> lock(gainMutex);
+    blockingGains[GainKey(width, height, static_cast<int>(topology), threads)] = gain;
+}
+
+// Pick the engine that should be fastest for a board
+EngineKind ChooseEngine(long long width, long long height, double density, Topology topology, int threads) {
+    long long cells = width * height;
+    long long packedBytes = cells / 8;
+
+    // Boards the size of the GUI grid fit one word per row with the rows unrolled
+    if (width <= FixedEngine::MaxSize && height <= FixedEngine::MaxSize) {
+        return EngineKind::Fixed;
+    }
+
+    // Boards that won't fit comfortably in memory live in a backing file
+    if (packedBytes > OutOfCoreBytes) {
+        return EngineKind::Mapped;
+    }
+
+    // Nearly empty boards: only the cells around last generation's changes are revisited.
+    // Past what fits in memory a byte per cell, the tiled engine still skips the empty tiles.
+    if (density < SparseDensity) {
+        return cells <= ChangeListMaxCells ? EngineKind::ChangeList : EngineKind::Mapped;
+    }
+
+    // Boards that fit in cache next to their sandbox gain nothing from blocking
+    static const size_t cacheBytes = BlockedStepper::DetectCacheSize();
+    if (static_cast<size_t>(packedBytes) * 2 <= cacheBytes / 2) {
+        return EngineKind::BitParallel;
+    }
+
+    // A board joined top to bottom that is shorter than a few halos wraps its halo back onto
+    // the tile, so most of the blocked work would be recomputation
+    static const int depth = BlockedStepper().GetDepth();
+    if (WrapsRows(topology) && height < 4LL * depth) {
+        return EngineKind::BitParallel;
+    }
+
+    // Otherwise it depends on the machine: several band threads or wrapped rows can make plain
+    // stepping win, so blocking is only picked when a calibration run shows it is faster
+    double gain = GetBlockingGain(static_cast<int>(width), static_cast<int>(height), topology, threads);
+    return gain >= BlockingMargin ? EngineKind::Blocked : EngineKind::BitParallel;
+}
+
+// Pick among the engines that keep plain packed rows: never sparse, and boards too big for
+// memory still get the blocked stepper
+EngineKind ChoosePackedEngine(int width, int height, Topology topology) {
+    EngineKind kind = ChooseEngine(width, height, 1.0, topology);
+    return kind == EngineKind::Mapped ? EngineKind::Blocked : kind;
+}
+
+// Create an engine of the given kind
+std::unique_ptr<LifeEngine> CreateEngine(EngineKind kind, const EngineOptions& options) {
+    switch (kind) {
+    case EngineKind::Naive:
+        return std::unique_ptr<LifeEngine>(new NaiveEngine());
+    case EngineKind::Blocked: {
+        BitEngine* engine = new BitEngine(true);
+        if (options.cacheBytes > 0) {
+            engine->ConfigureCache(options.cacheBytes);
+        }
+        return std::unique_ptr<LifeEngine>(engine);
+    }
+    case EngineKind::Mapped:
+        return std::unique_ptr<LifeEngine>(new MappedEngine(options.backingFile));
+    case EngineKind::Fixed:
+        return std::unique_ptr<LifeEngine>(new FixedEngine());
+    case EngineKind::ChangeList:
+        return std::unique_ptr<LifeEngine>(new ChangeListEngine());
+    case EngineKind::Automatic:
+    case EngineKind::BitParallel:
+    default: {
+        BitEngine* engine = new BitEngine(false);
+        engine->SetThreads(options.threads);
+        return std::unique_ptr<LifeEngine>(engine);
+    }
+    }
+}
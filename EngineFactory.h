@@ -0,0 +1,49 @@
+#ifndef ENGINEFACTORY_H
+#define ENGINEFACTORY_H
+
+#include "LifeEngine.h"
+#include <cstddef>  // size_t
+#include <memory>   // std::unique_ptr
+#include <string>
+
+// Engines that can be selected in Settings or on the command line.
+// The numeric values are stored in settings.bin, so only ever append to this list.
+enum class EngineKind {
+    Automatic = 0,                                    // Pick from the board size, density and boundary type
+    Naive,                                            // Cell-by-cell reference algorithm
+    BitParallel,                                      // 64 cells per word operation
+    Blocked,                                          // Bit-parallel with cache (temporal) blocking
+    Mapped,                                           // Out-of-core tiles in a memory-mapped file
+    Fixed,                                            // One word per row, unrolled for boards up to 64 x 64
+    ChangeList                                        // Only revisits cells around last generation's changes
+};
+
+const int EngineKindCount = 7;
+
+// Extra knobs for engines that need them
+struct EngineOptions {
+    std::string backingFile;                          // Backing file for the memory-mapped engine ("" for a unique temp file)
+    size_t cacheBytes = 0;                            // Cache size for blocking (0 = detect)
+    int threads = 1;                                  // Band threads for the bit-parallel engine
+};
+
+const char* GetEngineKindName(EngineKind kind);      // Name shown in the settings dialog and CLI
+bool ParseEngineKind(const std::string& name, EngineKind& kind);  // Inverse of GetEngineKindName (case-insensitive)
+
+// Pick the engine that should be fastest for a board (never returns Automatic). `threads` is
+// how many bands the bit-parallel engine would step on; cache blocking has to beat that.
+EngineKind ChooseEngine(long long width, long long height, double density, Topology topology, int threads = 1);
+
+// The same choice among the engines that keep the board as plain packed rows (Fixed-size,
+// Bit-parallel or Cache-blocked), for callers that read the rows directly like the C interface
+EngineKind ChoosePackedEngine(int width, int height, Topology topology);
+
+// How much faster the cache-blocked stepper is than plain stepping (banded on `threads`
+// threads) for a board of this shape. Timed once on a short calibration run, then remembered.
+double GetBlockingGain(int width, int height, Topology topology, int threads);
+void RecordBlockingGain(int width, int height, Topology topology, int threads, double gain);  // Use a gain measured elsewhere (bench)
+
+// Create an engine of the given kind; Automatic is treated as BitParallel
+std::unique_ptr<LifeEngine> CreateEngine(EngineKind kind, const EngineOptions& options = EngineOptions());
+
+#endif // ENGINEFACTORY_H
@@ -0,0 +1,327 @@
+#include "EngineVerifier.h"
+#include "BandPool.h"
+#include "BoardBatch.h"
+#include "NaiveEngine.h"
+#include <cstdio>   // std::snprintf
+#include <cstring>  // std::strcmp for the lane classifications
+#include <memory>
+#include <random>   // std::mt19937 for reproducible random boards
+#include <utility>  // std::move
+
+namespace {
+    // Describe where an engine first differs from the reference
+    std::string DescribeMismatch(const LifeEngine& reference, const LifeEngine& engine,
+                                 int board, int generation, Topology topology) {
+        char buffer[256];
+        for (int row = 0; row < reference.GetHeight(); ++row) {
+            for (int col = 0; col < reference.GetWidth(); ++col) {
+                if (reference.GetCell(row, col) != engine.GetCell(row, col)) {
+                    std::snprintf(buffer, sizeof(buffer),
+                        "%s differs from %s on board %d (%d x %d, %s) at generation %d, first at cell (%d, %d)",
+                        engine.GetName(), reference.GetName(), board, reference.GetWidth(), reference.GetHeight(),
+                        GetTopologyName(topology), generation, row, col);
+                    return buffer;
+                }
+            }
+        }
+
+        std::snprintf(buffer, sizeof(buffer),
+            "%s hash differs from %s on board %d at generation %d, but every cell matches",
+            engine.GetName(), reference.GetName(), board, generation);
+        return buffer;
+    }
+
+    // Compare an engine's region queries (live bounds, counts over random rectangles, next live
+    // cell from random starts) against the reference's plain scans; false with `report` set on a mismatch
+    bool CheckRegionQueries(const LifeEngine& reference, const LifeEngine& engine, std::mt19937& random,
+                            int board, int generation, std::string& report) {
+        int width = reference.GetWidth(), height = reference.GetHeight();
+        char buffer[256];
+
+        int top = 0, left = 0, bottom = 0, right = 0, expectedTop = 0, expectedLeft = 0, expectedBottom = 0, expectedRight = 0;
+        bool found = engine.GetLiveBounds(top, left, bottom, right);
+        bool expectedFound = reference.GetLiveBounds(expectedTop, expectedLeft, expectedBottom, expectedRight);
+        if (found != expectedFound ||
+            (found && (top != expectedTop || left != expectedLeft || bottom != expectedBottom || right != expectedRight))) {
+            std::snprintf(buffer, sizeof(buffer), "%s live bounds differ from %s on board %d at generation %d",
+                engine.GetName(), reference.GetName(), board, generation);
+            report = buffer;
+            return false;
+        }
+
+        for (int query = 0; query < 8; ++query) {
+            // Rectangles and starts may stick out past the board; the queries clip them
+            int row = static_cast<int>(random() % (height + 4)) - 2;
+            int col = static_cast<int>(random() % (width + 4)) - 2;
+            int rows = static_cast<int>(random() % (height + 3));
+            int cols = static_cast<int>(random() % (width + 3));
+
+            if (engine.CountRegion(row, col, rows, cols) != reference.CountRegion(row, col, rows, cols)) {
+                std::snprintf(buffer, sizeof(buffer), "%s counts region (%d, %d) %d x %d differently from %s on board %d at generation %d",
+                    engine.GetName(), row, col, cols, rows, reference.GetName(), board, generation);
+                report = buffer;
+                return false;
+            }
+
+            int nextRow = row, nextCol = col, expectedRow = row, expectedCol = col;
+            found = engine.FindNextLiveCell(nextRow, nextCol);
+            expectedFound = reference.FindNextLiveCell(expectedRow, expectedCol);
+            if (found != expectedFound || (found && (nextRow != expectedRow || nextCol != expectedCol))) {
+                std::snprintf(buffer, sizeof(buffer), "%s finds a different next live cell after (%d, %d) than %s on board %d at generation %d",
+                    engine.GetName(), row, col, reference.GetName(), board, generation);
+                report = buffer;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// Returns true if every engine matched the reference
+bool VerifyEngines(const std::vector<EngineKind>& kinds, const VerifyOptions& options, std::string& report) {
+    std::mt19937 random(options.seed);
+    std::mt19937 queryRandom(options.seed + 1);      // Separate, so the boards don't depend on the queries
+    std::vector<int> covered(kinds.size(), 0);        // Boards each engine actually stepped
+
+    for (int board = 0; board < options.boards; ++board) {
+        int size = board % 2 == 1 && options.smallSize < options.maxSize ? options.smallSize : options.maxSize;
+        int width = 1 + static_cast<int>(random() % size);
+        int height = 1 + static_cast<int>(random() % size);
+        int density = static_cast<int>(random() % 101);
+        Topology topology = static_cast<Topology>(random() % TopologyCount);
+
+        NaiveEngine reference;
+        reference.Resize(width, height);
+        reference.SetTopology(topology);
+
+        // Each engine is run twice: once in lockstep with the reference, and once stepping all
+        // generations in a single call, which is where multi-generation tricks like blocking kick in
+        std::vector<std::unique_ptr<LifeEngine>> engines, bulkEngines;
+        for (size_t i = 0; i < kinds.size(); ++i) {
+            std::unique_ptr<LifeEngine> engine = CreateEngine(kinds[i], options.engineOptions);
+            std::unique_ptr<LifeEngine> bulkEngine = CreateEngine(kinds[i], options.engineOptions);
+            engine->Resize(width, height);
+            bulkEngine->Resize(width, height);
+
+            // Engines limited to smaller boards refuse the resize; they sit this board out
+            if (engine->GetWidth() != width || engine->GetHeight() != height ||
+                bulkEngine->GetWidth() != width || bulkEngine->GetHeight() != height) {
+                continue;
+            }
+
+            engine->SetTopology(topology);
+            bulkEngine->SetTopology(topology);
+            engines.push_back(std::move(engine));
+            bulkEngines.push_back(std::move(bulkEngine));
+            covered[i]++;
+        }
+
+        for (int row = 0; row < height; ++row) {
+            for (int col = 0; col < width; ++col) {
+                bool alive = static_cast<int>(random() % 100) < density;
+                reference.SetCell(row, col, alive);
+                for (size_t i = 0; i < engines.size(); ++i) {
+                    engines[i]->SetCell(row, col, alive);
+                    bulkEngines[i]->SetCell(row, col, alive);
+                }
+            }
+        }
+
+        for (int generation = 0; generation <= options.generations; ++generation) {
+            if (generation > 0) {
+                reference.Step(1);
+                for (auto& engine : engines) {
+                    engine->Step(1);
+                }
+            }
+
+            uint64_t expected = reference.Hash();
+            long long population = reference.Population();
+            for (auto& engine : engines) {
+                if (engine->Hash() != expected || engine->Population() != population) {
+                    report = DescribeMismatch(reference, *engine, board, generation, topology);
+                    return false;
+                }
+
+                // Region queries on a few generations: the summaries are kept current by Step and SetCell
+                bool checkQueries = generation % 16 == 0 || generation == options.generations;
+                if (checkQueries && !CheckRegionQueries(reference, *engine, queryRandom, board, generation, report)) {
+                    return false;
+                }
+            }
+        }
+
+        uint64_t expected = reference.Hash();
+        for (auto& engine : bulkEngines) {
+            engine->Step(options.generations);
+            if (engine->Hash() != expected) {
+                report = DescribeMismatch(reference, *engine, board, options.generations, topology) + " (single Step call)";
+                return false;
+            }
+            if (!CheckRegionQueries(reference, *engine, queryRandom, board, options.generations, report)) {
+                report += " (single Step call)";
+                return false;
+            }
+        }
+    }
+
+    // Report how many boards each engine covered; one that covered none was never tested at all
+    char buffer[256];
+    std::string coverage = "boards covered:";
+    std::string uncovered;
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        std::snprintf(buffer, sizeof(buffer), "%s %s %d", i == 0 ? "" : ",", GetEngineKindName(kinds[i]), covered[i]);
+        coverage += buffer;
+        if (covered[i] == 0) {
+            uncovered += uncovered.empty() ? GetEngineKindName(kinds[i]) : std::string(", ") + GetEngineKindName(kinds[i]);
+        }
+    }
+
+    if (!uncovered.empty()) {
+        report = uncovered + " refused every board, so nothing was verified (" + coverage + "); try a smaller --max-size";
+        return false;
+    }
+
+    std::snprintf(buffer, sizeof(buffer), "%d engines matched %s on %d boards for %d generations each (",
+        static_cast<int>(kinds.size()), NaiveEngine().GetName(), options.boards, options.generations);
+    report = buffer + coverage + ")";
+    return true;
+}
+
+// Returns true if every lane of every batch matched the reference
+bool VerifyBoardBatch(const VerifyOptions& options, std::string& report) {
+    std::mt19937 random(options.seed);
+    int batches = options.boards / 10 > 0 ? options.boards / 10 : 1;
+    int maxSize = options.smallSize / 2 > 0 ? options.smallSize / 2 : 1;
+
+    for (int batchIndex = 0; batchIndex < batches; ++batchIndex) {
+        int width = 1 + static_cast<int>(random() % maxSize);
+        int height = 1 + static_cast<int>(random() % maxSize);
+        Topology topology = static_cast<Topology>(random() % TopologyCount);
+
+        BoardBatch batch(width, height, topology);
+        std::vector<NaiveEngine> references(BoardBatch::Lanes);
+        std::vector<uint64_t> previousHashes(BoardBatch::Lanes);  // Reference hash one generation back
+        std::vector<uint64_t> olderHashes(BoardBatch::Lanes);     // And two generations back
+        for (int lane = 0; lane < BoardBatch::Lanes; ++lane) {
+            NaiveEngine& reference = references[lane];
+            reference.Resize(width, height);
+            reference.SetTopology(topology);
+
+            int density = static_cast<int>(random() % 101);
+            for (int row = 0; row < height; ++row) {
+                for (int col = 0; col < width; ++col) {
+                    bool alive = static_cast<int>(random() % 100) < density;
+                    reference.SetCell(row, col, alive);
+                    batch.SetCell(lane, row, col, alive);
+                }
+            }
+            previousHashes[lane] = reference.Hash();
+        }
+
+        for (int generation = 1; generation <= options.generations; ++generation) {
+            batch.Step();
+            for (int lane = 0; lane < BoardBatch::Lanes; ++lane) {
+                NaiveEngine& reference = references[lane];
+                reference.Step(1);
+
+                for (int row = 0; row < height; ++row) {
+                    for (int col = 0; col < width; ++col) {
+                        if (reference.GetCell(row, col) != batch.GetCell(lane, row, col)) {
+                            char buffer[256];
+                            std::snprintf(buffer, sizeof(buffer),
+                                "Board batch differs from %s in lane %d of batch %d (%d x %d, %s) at generation %d, first at cell (%d, %d)",
+                                reference.GetName(), lane, batchIndex, width, height, GetTopologyName(topology), generation, row, col);
+                            report = buffer;
+                            return false;
+                        }
+                    }
+                }
+
+                // The batch's classification must agree with one taken from the reference's hashes
+                // over the same generations
+                uint64_t hash = reference.Hash();
+                const char* expected = "running";
+                if (reference.Population() == 0) {
+                    expected = "extinct";
+                }
+                else if (hash == previousHashes[lane]) {
+                    expected = "still";
+                }
+                else if (generation > 1 && hash == olderHashes[lane]) {
+                    expected = "oscillating";
+                }
+
+                uint64_t bit = 1ULL << lane;
+                const char* classified = "running";
+                if (batch.GetExtinctLanes() & bit) {
+                    classified = "extinct";
+                }
+                else if (batch.GetStillLanes() & bit) {
+                    classified = "still";
+                }
+                else if (batch.GetOscillatingLanes() & bit) {
+                    classified = "oscillating";
+                }
+
+                if (std::strcmp(expected, classified) != 0) {
+                    char buffer[256];
+                    std::snprintf(buffer, sizeof(buffer),
+                        "Board batch classified lane %d of batch %d (%d x %d, %s) as %s at generation %d, but %s's hashes say %s",
+                        lane, batchIndex, width, height, GetTopologyName(topology), classified, generation, reference.GetName(), expected);
+                    report = buffer;
+                    return false;
+                }
+                olderHashes[lane] = previousHashes[lane];
+                previousHashes[lane] = hash;
+            }
+        }
+    }
+
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "%d board batches of %d lanes matched %s for %d generations each, settled lanes included",
+        batches, BoardBatch::Lanes, NaiveEngine().GetName(), options.generations);
+    report = buffer;
+    return true;
+}
+
+// Returns true if every band split covered its board as promised
+bool VerifyBandRows(std::string& report) {
+    const int maxBands = 64;
+    long long splits = 0;
+    for (int bands = 1; bands <= maxBands; ++bands) {
+        for (int height = 0; height <= 64 * bands + 200; ++height) {
+            int expectedFirst = 0;
+            for (int band = 0; band < bands; ++band) {
+                int first, end;
+                BandPool::GetBandRows(band, bands, height, first, end);
+
+                const char* problem = nullptr;
+                if (first != expectedFirst || end < first || (band == bands - 1 && end != height)) {
+                    problem = "leaves a gap or overlaps";
+                }
+                else if (height >= bands && end == first) {
+                    problem = "is empty";
+                }
+                else if (BandPool::BandsOwnTiles(bands, height) && first % 64 != 0) {
+                    problem = "doesn't start on a tile";
+                }
+
+                if (problem) {
+                    char buffer[160];
+                    std::snprintf(buffer, sizeof(buffer), "Band %d of %d on a board %d rows tall %s (rows %d to %d)",
+                        band, bands, height, problem, first, end);
+                    report = buffer;
+                    return false;
+                }
+                expectedFirst = end;
+            }
+            ++splits;
+        }
+    }
+
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "%lld band splits of 1 to %d bands covered their rows", splits, maxBands);
+    report = buffer;
+    return true;
+}
@@ -0,0 +1,36 @@
+#ifndef ENGINEVERIFIER_H
+#define ENGINEVERIFIER_H
+
+#include "EngineFactory.h"
+#include <string>
+#include <vector>
+
+// Differential testing of the engines: random boards are loaded into every engine, stepped in
+// lockstep and compared by hash after every generation against NaiveEngine, whose semantics
+// are the definition of the game. Any divergence is reported with the first differing cell.
+// Region queries (CountRegion, GetLiveBounds, FindNextLiveCell) are checked on a few generations too.
+struct VerifyOptions {
+    int boards = 50;                                  // Number of random boards to try
+    int generations = 64;                             // Generations stepped per board
+    int maxSize = 256;                                // Boards are 1..maxSize cells on each side
+    int smallSize = 64;                               // Every other board is at most this big, for the small-board engines
+    unsigned int seed = 1;                            // Seed for board sizes, densities and contents
+    EngineOptions engineOptions;                      // Passed to CreateEngine for every engine
+};
+
+// Returns true if every engine matched the reference; `report` describes the run (with the boards
+// each engine covered) or the failure. An engine that refused every board counts as a failure.
+bool VerifyEngines(const std::vector<EngineKind>& kinds, const VerifyOptions& options, std::string& report);
+
+// The same check for BoardBatch: every lane gets its own random board (of sizes up to half of
+// smallSize, where seed sweeps run) and must match a reference engine cell for cell. Every
+// generation the batch's extinct/still/oscillating lanes must also agree with the reference's
+// population and its hashes of the two generations before.
+bool VerifyBoardBatch(const VerifyOptions& options, std::string& report);
+
+// Check how BandPool splits a board for 1..64 bands and every height up to a few tiles per band:
+// the bands must cover the rows in order without gaps, none may be empty once there are at
+// least as many rows as bands, and bands that own whole tiles must start on multiples of 64.
+bool VerifyBandRows(std::string& report);
+
+#endif // ENGINEVERIFIER_H
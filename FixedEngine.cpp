@@ -0,0 +1,125 @@
+#include "FixedEngine.h"
+#include "BitKernel.h"   // Bit-parallel rules used to step each row
+#include <algorithm>     // std::copy
+#include <utility>       // std::index_sequence for unrolling the rows
+
+namespace {
+    // Edge handling for one board, worked out once per Step call so the generation loop
+    // only does masking and shifting
+    struct EdgeMasks {
+        EdgeMasks(int width, Topology topology)
+            : lastColumn(width - 1),
+              columns(LowBits(width)),
+              wrapColumns(WrapsColumns(topology) ? 1 : 0),
+              wrapRows(WrapsRows(topology) ? ~0ULL : 0),
+              mirrorRows(topology == Topology::KleinBottle) {}
+
+        int lastColumn;                               // Shift from column 0 to the last column
+        uint64_t columns;                             // Bits that are on the board
+        uint64_t wrapColumns;                         // 1 if the left and right edges are joined
+        uint64_t wrapRows;                            // All ones if the top and bottom edges are joined
+        bool mirrorRows;                              // True if crossing the top/bottom edge mirrors the row
+
+        // Cells left/right of each cell, with the ghost column past the edge filled in
+        uint64_t West(uint64_t row) const { return (row << 1) | ((row >> lastColumn) & wrapColumns); }
+        uint64_t East(uint64_t row) const { return (row >> 1) | ((row & wrapColumns) << lastColumn); }
+
+        // The ghost row that stands in for `row` past the top/bottom edge
+        uint64_t Ghost(uint64_t row) const {
+            if (mirrorRows) {
+                row = ReverseBits(row) >> (63 - lastColumn);  // Only Klein bottles pay for the reversal
+            }
+            return row & wrapRows;
+        }
+    };
+
+    template <int Rows>
+    class FixedBoard {
+    public:
+        // Advance a board of this height; the rows are copied into a local array so they can stay in registers
+        static void Step(uint64_t* cells, int width, Topology topology, int generations) {
+            FixedBoard board;
+            std::copy(cells, cells + Rows, board.rows.begin());
+
+            EdgeMasks masks(width, topology);
+            for (int generation = 0; generation < generations; ++generation) {
+                board.Next(masks, std::make_index_sequence<Rows>());
+            }
+
+            std::copy(board.rows.begin(), board.rows.end(), cells);
+        }
+
+    private:
+        std::array<uint64_t, Rows> rows;
+
+        // One generation. The pack expansions write out every row, so the loop over rows is
+        // unrolled at compile time; entries 0 and Rows + 1 of the padded arrays are the ghost rows.
+        template <size_t... Row>
+        void Next(const EdgeMasks& masks, std::index_sequence<Row...>) {
+            const std::array<uint64_t, Rows + 2> center = {{
+                masks.Ghost(rows[Rows - 1]), rows[Row]..., masks.Ghost(rows[0]) }};
+            const std::array<uint64_t, Rows + 2> west = {{
+                masks.West(center[0]), masks.West(center[Row + 1])..., masks.West(center[Rows + 1]) }};
+            const std::array<uint64_t, Rows + 2> east = {{
+                masks.East(center[0]), masks.East(center[Row + 1])..., masks.East(center[Rows + 1]) }};
+
+            rows = {{ (ApplyRule(west[Row], center[Row], east[Row],
+                                 west[Row + 1], east[Row + 1],
+                                 west[Row + 2], center[Row + 2], east[Row + 2],
+                                 center[Row + 1]) & masks.columns)... }};
+        }
+    };
+
+    // Used while the engine is empty
+    void StepNothing(uint64_t*, int, Topology, int) {}
+
+    // Table of the specializations for heights 1 to MaxSize, built at compile time
+    template <size_t... Height>
+    FixedEngine::StepFunction SelectStep(int height, std::index_sequence<Height...>) {
+        static const FixedEngine::StepFunction steppers[] = { &FixedBoard<static_cast<int>(Height) + 1>::Step... };
+        return steppers[height - 1];
+    }
+}
+
+FixedEngine::FixedEngine() : step(&StepNothing) {
+    rows.fill(0);
+}
+
+// True if a board of this size fits
+bool FixedEngine::Supports(int width, int height) {
+    return width > 0 && width <= MaxSize && height > 0 && height <= MaxSize;
+}
+
+// Change the board size, killing every cell, and pick the stepper for the new height
+void FixedEngine::Resize(int newWidth, int newHeight) {
+    rows.fill(0);
+
+    if (!Supports(newWidth, newHeight)) {
+        width = 0;
+        height = 0;
+        step = &StepNothing;
+        return;
+    }
+
+    width = newWidth;
+    height = newHeight;
+    step = SelectStep(height, std::make_index_sequence<MaxSize>());
+}
+
+// Count living cells
+long long FixedEngine::Population() const {
+    long long population = 0;
+    for (int row = 0; row < height; ++row) {
+        population += CountBits(rows[row]);
+    }
+    return population;
+}
+
+// Every row is a single word, which is already the shared hash layout
+uint64_t FixedEngine::Hash() const {
+    uint64_t hash = HashSeed(width, height);
+    for (int row = 0; row < height; ++row) {
+        hash = HashWord(hash, rows[row]);
+    }
+    return hash;
+}
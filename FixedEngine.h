@@ -0,0 +1,50 @@
+#ifndef FIXEDENGINE_H
+#define FIXEDENGINE_H
+
+#include "LifeEngine.h"
+#include <array>    // Fixed-size row storage
+
+// Engine for boards up to 64 x 64, the range the GUI grid lives in. Every row is a single
+// 64-bit word in a fixed-size array, so nothing is heap allocated and there are no per-word
+// loops. The step is a template specialized for each board height, with the rows unrolled at
+// compile time; Resize picks the specialization for the new height at run time.
+class FixedEngine : public LifeEngine {
+public:
+    static const int MaxSize = 64;                    // Largest supported width and height
+
+    // Signature of the height-specialized steppers
+    typedef void (*StepFunction)(uint64_t* rows, int width, Topology topology, int generations);
+
+    FixedEngine();
+
+    const char* GetName() const override { return "Fixed-size"; }
+
+    // Boards bigger than MaxSize x MaxSize aren't supported and leave the engine empty (0 x 0)
+    void Resize(int width, int height) override;
+    int GetWidth() const override { return width; }
+    int GetHeight() const override { return height; }
+    void SetTopology(Topology newTopology) override { topology = newTopology; }
+
+    bool GetCell(int row, int col) const override { return (rows[row] >> col) & 1; }
+    void SetCell(int row, int col, bool alive) override {
+        uint64_t bit = 1ULL << col;
+        rows[row] = alive ? (rows[row] | bit) : (rows[row] & ~bit);
+    }
+    void Clear() override { rows.fill(0); }
+
+    void Step(int generations) override { step(rows.data(), width, topology, generations); }
+    long long Population() const override;
+    uint64_t Hash() const override;
+
+    static bool Supports(int width, int height);     // True if a board of this size fits
+    const uint64_t* GetRows() const { return rows.data(); }  // Packed rows, one word each (bits past the width stay zero)
+
+private:
+    std::array<uint64_t, MaxSize> rows;               // One word per row, bit j = column j
+    int width = 0;
+    int height = 0;
+    Topology topology = Topology::Finite;             // How the board edges are joined
+    StepFunction step;                                // Stepper specialized for the current height
+};
+
+#endif // FIXEDENGINE_H
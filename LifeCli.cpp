@@ -0,0 +1,584 @@
+// Headless command line driver for the simulation, for boards and workloads that don't fit the GUI.
+//
+// Usage:
+//   LifeCli run --board <file> --width <cells> --height <cells> [--pattern <file.cells>]
+//               [--generations <count>] [--topology <name>]
+//   LifeCli bench --width <cells> --height <cells> [--generations <count>] [--density <percent>]
+//                 [--seed <number>] [--cache <bytes>] [--topology <name>] [--threads <count>]
+//                 [--huge-pages off|transparent|explicit]
+//   LifeCli verify [--engines <name,name,...>] [--boards <count>] [--generations <count>]
+//                  [--max-size <cells>] [--seed <number>] [--cache <bytes>] [--threads <count>]
+//   LifeCli sweep [--width <cells>] [--height <cells>] [--seeds <count>] [--first-seed <number>]
+//                 [--density <percent>] [--generations <count>] [--topology <name>] [--list]
+//   LifeCli stats --width <cells> --height <cells> [--pattern <file.cells> | --density <percent> --seed <number>]
+//                 [--generations <count>] [--topology <name>] [--engine <name>]
+//                 [--region <row,col,rows,cols>] [--next <row,col>]
+//
+// run: the board lives in a memory-mapped tile file, so it can be far bigger than physical RAM.
+//      Reopening an existing board file continues from the generation it was left at.
+// bench: compares single-generation stepping against the cache-blocked stepper on a random board,
+//        and with --threads against banded stepping on that many threads. Ends with what the
+//        board arena allocated and which NUMA nodes the boards' pages ended up on, and with the
+//        cost of a single Step(1) call on 8 x 8 and 64 x 64 boards.
+// verify: steps random boards on every engine in lockstep with the naive reference engine and
+//         fails on the first generation whose board hash differs.
+// sweep: fills a board for every seed the way the GUI's Randomize Grid does and runs it until it
+//        dies out, stops changing, oscillates with period 2 or hits --generations. 64 boards are
+//        stepped at once; --list prints the outcome of every seed.
+// stats: steps a board on one engine and reports its live bounding box, the living cells in
+//        --region and the first living cell at or after --next, timing the queries.
+//
+// Topologies: finite (the default), toroidal, cylinder and klein-bottle. --toroidal is short for
+// --topology toroidal.
+
+#include "BandPool.h"
+#include "BitBoard.h"
+#include "BoardArena.h"
+#include "BlockedStepper.h"
+#include "BoardBatch.h"
+#include "EngineFactory.h"
+#include "EngineVerifier.h"
+#include "MappedBoard.h"
+#include "Pattern.h"
+#include <chrono>    // Timing the run
+#include <climits>   // INT_MAX for the --generations range
+#include <cstdio>    // printf / fprintf
+#include <cstdlib>   // std::strtoll
+#include <map>
+#include <memory>    // std::unique_ptr for the per-call engines
+#include <string>
+#include <vector>
+
+namespace {
+    // Parse "--name value" pairs (and bare "--flag" switches) following the command
+    std::map<std::string, std::string> ParseOptions(int argc, char** argv, int first) {
+        std::map<std::string, std::string> options;
+        for (int i = first; i < argc; ++i) {
+            std::string name = argv[i];
+            if (name.compare(0, 2, "--") != 0) continue;
+            name = name.substr(2);
+
+            if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) {
+                options[name] = argv[++i];
+            }
+            else {
+                options[name] = "1";  // Switch without a value
+            }
+        }
+        return options;
+    }
+
+    long long GetNumber(const std::map<std::string, std::string>& options, const std::string& name, long long fallback) {
+        auto it = options.find(name);
+        return it == options.end() ? fallback : std::strtoll(it->second.c_str(), nullptr, 10);
+    }
+
+    int PrintUsage() {
+        std::fprintf(stderr,
+            "Usage:\n"
+            "  LifeCli run --board <file> --width <cells> --height <cells> [--pattern <file.cells>]\n"
+            "              [--generations <count>] [--topology <name>]\n"
+            "  LifeCli bench --width <cells> --height <cells> [--generations <count>] [--density <percent>]\n"
+            "                [--seed <number>] [--cache <bytes>] [--topology <name>] [--threads <count>]\n"
+            "                [--huge-pages off|transparent|explicit]\n"
+            "  LifeCli verify [--engines <name,name,...>] [--boards <count>] [--generations <count>]\n"
+            "                 [--max-size <cells>] [--seed <number>] [--cache <bytes>] [--threads <count>]\n"
+            "  LifeCli sweep [--width <cells>] [--height <cells>] [--seeds <count>] [--first-seed <number>]\n"
+            "                [--density <percent>] [--generations <count>] [--topology <name>] [--list]\n"
+            "  LifeCli stats --width <cells> --height <cells> [--pattern <file.cells> | --density <percent> --seed <number>]\n"
+            "                [--generations <count>] [--topology <name>] [--engine <name>]\n"
+            "                [--region <row,col,rows,cols>] [--next <row,col>]\n"
+            "Topologies: finite, toroidal, cylinder, klein-bottle\n");
+        return 1;
+    }
+
+    // Read --topology (or the --toroidal switch), returns false for an unknown topology name
+    bool GetTopology(const std::map<std::string, std::string>& options, Topology& topology) {
+        topology = options.count("toroidal") != 0 ? Topology::Toroidal : Topology::Finite;
+
+        auto it = options.find("topology");
+        if (it != options.end() && !ParseTopology(it->second, topology)) {
+            std::fprintf(stderr, "Unknown topology %s\n", it->second.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Step a memory-mapped board
+    int RunCommand(const std::map<std::string, std::string>& options) {
+        auto boardOption = options.find("board");
+        long long width = GetNumber(options, "width", 0);
+        long long height = GetNumber(options, "height", 0);
+        long long generations = GetNumber(options, "generations", 1);
+
+        Topology topology;
+        if (boardOption == options.end() || width <= 0 || height <= 0 || !GetTopology(options, topology)) {
+            return PrintUsage();
+        }
+        if (generations < 0 || generations > INT_MAX) {
+            std::fprintf(stderr, "--generations must be between 0 and %d\n", INT_MAX);
+            return PrintUsage();
+        }
+
+        // An existing board file only reopens with the size and topology it was created with
+        MappedBoard board;
+        if (!board.Open(boardOption->second, width, height, topology)) {
+            std::fprintf(stderr, "Failed to open board file %s (an existing file must match --width, --height and --topology)\n",
+                boardOption->second.c_str());
+            return 1;
+        }
+
+        // Place the pattern in the middle of the board, the same way the GUI imports patterns
+        auto patternOption = options.find("pattern");
+        if (patternOption != options.end()) {
+            std::vector<std::vector<bool>> pattern;
+            if (!LoadCellsPattern(patternOption->second, pattern) || pattern.empty()) {
+                std::fprintf(stderr, "Failed to load pattern %s\n", patternOption->second.c_str());
+                return 1;
+            }
+
+            long long startRow = (height - static_cast<long long>(pattern.size())) / 2;
+            long long startCol = (width - static_cast<long long>(pattern[0].size())) / 2;
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                for (size_t j = 0; j < pattern[i].size(); ++j) {
+                    if (pattern[i][j]) {
+                        board.SetCell(startRow + i, startCol + j, true);
+                    }
+                }
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        board.Step(static_cast<int>(generations));
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("Generations: %lld | Living Cells: %lld | %.3f s\n",
+            static_cast<long long>(board.GetGeneration()), static_cast<long long>(board.Population()), seconds);
+        return 0;
+    }
+
+    // Fill a board the same way the GUI's Randomize Grid does
+    void FillRandom(BitBoard& board, int seed, int density) {
+        srand(seed);
+        for (int row = 0; row < board.GetHeight(); ++row) {
+            for (int col = 0; col < board.GetWidth(); ++col) {
+                board.SetCell(row, col, (rand() % 100) < density);
+            }
+        }
+    }
+
+    // Print how much of a board's memory sits on each NUMA node
+    void PrintPlacement(const char* label, const BitBoard& board) {
+        std::vector<size_t> bytesPerNode;
+        if (!BoardArena::GetPlacement(board.GetData(), board.GetSizeBytes(), bytesPerNode)) {
+            std::printf("%s: NUMA placement not available on this system\n", label);
+            return;
+        }
+
+        std::printf("%s:", label);
+        for (size_t node = 0; node < bytesPerNode.size(); ++node) {
+            std::printf("%s node %d %.1f MB", node > 0 ? " |" : "", static_cast<int>(node), bytesPerNode[node] / 1048576.0);
+        }
+        std::printf("%s\n", bytesPerNode.empty() ? " not resident" : "");
+    }
+
+    // Average time of one Step(1) call on a small random board, where the per-call overhead of
+    // the engine matters more than its stepping speed (the library steps one call per frame)
+    double MeasureCallNanoseconds(EngineKind kind, int size, Topology topology, int seed, int density) {
+        const int calls = 20000;
+        std::unique_ptr<LifeEngine> engine = CreateEngine(kind);
+        engine->Resize(size, size);
+        engine->SetTopology(topology);
+
+        srand(seed);
+        for (int row = 0; row < size; ++row) {
+            for (int col = 0; col < size; ++col) {
+                engine->SetCell(row, col, (rand() % 100) < density);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < calls; ++i) {
+            engine->Step(1);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+    }
+
+    // Compare single-generation stepping against the cache-blocked stepper (and banded stepping)
+    int BenchCommand(const std::map<std::string, std::string>& options) {
+        int width = static_cast<int>(GetNumber(options, "width", 4096));
+        int height = static_cast<int>(GetNumber(options, "height", 4096));
+        int generations = static_cast<int>(GetNumber(options, "generations", 100));
+        int density = static_cast<int>(GetNumber(options, "density", 45));
+        int seed = static_cast<int>(GetNumber(options, "seed", 1));
+        int threads = static_cast<int>(GetNumber(options, "threads", 1));
+        Topology topology;
+
+        if (width <= 0 || height <= 0 || generations <= 0 || threads <= 0 || !GetTopology(options, topology)) {
+            return PrintUsage();
+        }
+
+        HugePages hugePages = BoardArena::Get().GetHugePages();
+        auto hugePagesOption = options.find("huge-pages");
+        if (hugePagesOption != options.end() && !ParseHugePages(hugePagesOption->second, hugePages)) {
+            std::fprintf(stderr, "Unknown huge page mode %s\n", hugePagesOption->second.c_str());
+            return 1;
+        }
+        BoardArena::Get().SetHugePages(hugePages);
+
+        BitBoard start(width, height);
+        FillRandom(start, seed, density);
+
+        // Baseline: one full pass over the board and its sandbox per generation
+        BitBoard single = start;
+        BitBoard sandbox;
+        auto singleStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < generations; ++i) {
+            StepBitBoard(single, sandbox, topology);
+            single.Swap(sandbox);
+        }
+        double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - singleStart).count();
+
+        BlockedStepper stepper;
+        long long cacheBytes = GetNumber(options, "cache", 0);
+        if (cacheBytes > 0) {
+            stepper.Configure(static_cast<size_t>(cacheBytes));
+        }
+
+        BitBoard blocked = start;
+        auto blockedStart = std::chrono::steady_clock::now();
+        stepper.Step(blocked, generations, topology);
+        double blockedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - blockedStart).count();
+
+        double cells = static_cast<double>(width) * height * generations;
+        std::printf("Board: %d x %d (%s) | %d generations\n", width, height, GetTopologyName(topology), generations);
+        std::printf("Single-step: %10.1f generations/s | %8.1f Mcells/s\n", generations / singleSeconds, cells / singleSeconds / 1e6);
+        std::printf("Blocked:     %10.1f generations/s | %8.1f Mcells/s (depth %d, tile %d rows x %d words, cache %zu KB)\n",
+            generations / blockedSeconds, cells / blockedSeconds / 1e6,
+            stepper.GetDepth(), stepper.GetTileRows(), stepper.GetTileWords(), stepper.GetCacheBytes() / 1024);
+        bool match = single == blocked;
+        double plainSeconds = singleSeconds;              // What the bit-parallel engine would take
+
+        if (threads > 1) {
+            // Each thread copies in (and so places) the band of rows it will step
+            BandPool bands(threads);
+            BitBoard banded, bandedSandbox;
+            banded.Resize(width, height, false);
+            bands.Run([&](int band) {
+                int first, end;
+                BandPool::GetBandRows(band, threads, height, first, end);
+                banded.CopyRows(start, band == 0 ? -1 : first, band == threads - 1 ? height + 1 : end);
+            });
+
+            auto bandedStart = std::chrono::steady_clock::now();
+            for (int i = 0; i < generations; ++i) {
+                StepBitBoard(banded, bandedSandbox, topology, bands);
+                banded.Swap(bandedSandbox);
+            }
+            double bandedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - bandedStart).count();
+
+            std::printf("Banded:      %10.1f generations/s | %8.1f Mcells/s (%d threads)\n",
+                generations / bandedSeconds, cells / bandedSeconds / 1e6, threads);
+            PrintPlacement("Banded board placement", banded);
+            match = match && single == banded;
+            plainSeconds = bandedSeconds;
+        }
+        else {
+            PrintPlacement("Board placement", single);
+        }
+
+        ArenaStats arena = BoardArena::Get().GetStats();
+        std::printf("Arena: %lld buffers (%lld reused) | %.1f MB mapped, %.1f MB cached | huge pages %s, %.1f MB\n",
+            arena.acquired, arena.reused, arena.mappedBytes / 1048576.0, arena.cachedBytes / 1048576.0,
+            GetHugePagesName(hugePages), arena.hugePageBytes / 1048576.0);
+        std::printf("Speedup: %.2fx | Boards %s | Living Cells: %lld\n", singleSeconds / blockedSeconds,
+            match ? "match" : "DIFFER", blocked.Population());
+
+        // The measured gain stands in for the engine chooser's own calibration run
+        RecordBlockingGain(width, height, topology, threads, plainSeconds / blockedSeconds);
+        std::printf("Automatic: %s (blocked %.2fx %s)\n",
+            GetEngineKindName(ChooseEngine(width, height, density / 100.0, topology, threads)),
+            plainSeconds / blockedSeconds, threads > 1 ? "banded" : "single-step");
+
+        // What one call costs on the boards libgameoflife hands to the fixed-size engine
+        std::printf("Per call:");
+        const int callSizes[] = { 8, 64 };
+        for (int i = 0; i < 2; ++i) {
+            int size = callSizes[i];
+            EngineKind kind = ChoosePackedEngine(size, size, topology);
+            std::printf("%s %d x %d %s %.0f ns/step (Bit-parallel %.0f ns)", i > 0 ? " |" : "", size, size,
+                GetEngineKindName(kind), MeasureCallNanoseconds(kind, size, topology, seed, density),
+                MeasureCallNanoseconds(EngineKind::BitParallel, size, topology, seed, density));
+        }
+        std::printf("\n");
+
+        return match ? 0 : 1;
+    }
+
+    // Differential test of the engines against the naive reference
+    int VerifyCommand(const std::map<std::string, std::string>& options) {
+        std::vector<EngineKind> kinds;
+        auto enginesOption = options.find("engines");
+
+        if (enginesOption == options.end()) {
+            // Everything except the reference itself and the automatic choice
+            for (int index = static_cast<int>(EngineKind::BitParallel); index < EngineKindCount; ++index) {
+                kinds.push_back(static_cast<EngineKind>(index));
+            }
+        }
+        else {
+            std::string names = enginesOption->second;
+            size_t start = 0;
+            while (start <= names.size()) {
+                size_t end = names.find(',', start);
+                if (end == std::string::npos) end = names.size();
+
+                EngineKind kind;
+                std::string name = names.substr(start, end - start);
+                if (!ParseEngineKind(name, kind) || kind == EngineKind::Automatic) {
+                    std::fprintf(stderr, "Unknown engine %s\n", name.c_str());
+                    return 1;
+                }
+                kinds.push_back(kind);
+                start = end + 1;
+            }
+        }
+
+        VerifyOptions verifyOptions;
+        verifyOptions.boards = static_cast<int>(GetNumber(options, "boards", verifyOptions.boards));
+        verifyOptions.generations = static_cast<int>(GetNumber(options, "generations", verifyOptions.generations));
+        verifyOptions.maxSize = static_cast<int>(GetNumber(options, "max-size", verifyOptions.maxSize));
+        verifyOptions.seed = static_cast<unsigned int>(GetNumber(options, "seed", verifyOptions.seed));
+
+        // More than one band by default, so the banded stepping path is covered too
+        verifyOptions.engineOptions.threads = static_cast<int>(GetNumber(options, "threads", 2));
+
+        // A small cache makes the blocked engine actually block on the small test boards
+        verifyOptions.engineOptions.cacheBytes = static_cast<size_t>(GetNumber(options, "cache", 16 * 1024));
+
+        if (verifyOptions.boards <= 0 || verifyOptions.generations < 0 || verifyOptions.maxSize <= 0 ||
+            verifyOptions.engineOptions.threads <= 0) {
+            return PrintUsage();
+        }
+
+        std::string report;
+        bool passed = VerifyEngines(kinds, verifyOptions, report);
+        std::printf("%s: %s\n", passed ? "PASSED" : "FAILED", report.c_str());
+
+        // The lane-parallel batch and the band split aren't engines; check them along with the full set
+        if (passed && enginesOption == options.end()) {
+            passed = VerifyBoardBatch(verifyOptions, report);
+            std::printf("%s: %s\n", passed ? "PASSED" : "FAILED", report.c_str());
+        }
+        if (passed && enginesOption == options.end()) {
+            passed = VerifyBandRows(report);
+            std::printf("%s: %s\n", passed ? "PASSED" : "FAILED", report.c_str());
+        }
+        return passed ? 0 : 1;
+    }
+
+    // Run many random seeds to the end, 64 boards at a time
+    int SweepCommand(const std::map<std::string, std::string>& options) {
+        SweepOptions sweepOptions;
+        sweepOptions.width = static_cast<int>(GetNumber(options, "width", sweepOptions.width));
+        sweepOptions.height = static_cast<int>(GetNumber(options, "height", sweepOptions.height));
+        sweepOptions.seeds = static_cast<int>(GetNumber(options, "seeds", sweepOptions.seeds));
+        sweepOptions.firstSeed = static_cast<int>(GetNumber(options, "first-seed", sweepOptions.firstSeed));
+        sweepOptions.density = static_cast<int>(GetNumber(options, "density", sweepOptions.density));
+        sweepOptions.maxGenerations = static_cast<int>(GetNumber(options, "generations", sweepOptions.maxGenerations));
+
+        if (sweepOptions.width <= 0 || sweepOptions.height <= 0 || sweepOptions.seeds <= 0 ||
+            sweepOptions.maxGenerations <= 0 || !GetTopology(options, sweepOptions.topology)) {
+            return PrintUsage();
+        }
+
+        std::vector<SweepResult> results;
+        auto start = std::chrono::steady_clock::now();
+        long long boardGenerations = SweepSeeds(sweepOptions, results);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        int counts[SweepOutcomeCount] = {};
+        long long settledGenerations = 0;
+        const SweepResult* longest = nullptr;     // Longest lived seed that settled
+        for (const SweepResult& result : results) {
+            if (options.count("list") != 0) {
+                std::printf("%d %s %d %lld\n", result.seed, GetSweepOutcomeName(result.outcome), result.generations, result.population);
+            }
+
+            ++counts[static_cast<int>(result.outcome)];
+            if (result.outcome != SweepOutcome::Running) {
+                settledGenerations += result.generations;
+                if (!longest || result.generations > longest->generations) {
+                    longest = &result;
+                }
+            }
+        }
+
+        int settled = sweepOptions.seeds - counts[static_cast<int>(SweepOutcome::Running)];
+        std::printf("Board: %d x %d (%s) | seeds %d..%d | density %d%% | up to %d generations\n",
+            sweepOptions.width, sweepOptions.height, GetTopologyName(sweepOptions.topology),
+            sweepOptions.firstSeed, sweepOptions.firstSeed + sweepOptions.seeds - 1, sweepOptions.density, sweepOptions.maxGenerations);
+        for (int outcome = 0; outcome < SweepOutcomeCount; ++outcome) {
+            std::printf("%-12s %d\n", GetSweepOutcomeName(static_cast<SweepOutcome>(outcome)), counts[outcome]);
+        }
+        if (longest) {
+            std::printf("Settled after %.1f generations on average, longest seed %d (%d generations)\n",
+                static_cast<double>(settledGenerations) / settled, longest->seed, longest->generations);
+        }
+        std::printf("%.3f s | %.0f seeds/s | %.1f M board generations/s\n",
+            seconds, sweepOptions.seeds / seconds, boardGenerations / seconds / 1e6);
+        return 0;
+    }
+
+    // Read a comma-separated list of exactly `count` numbers, like --region 10,20,64,64
+    bool GetNumbers(const std::map<std::string, std::string>& options, const std::string& name, int count, long long* values) {
+        const char* text = options.find(name)->second.c_str();
+        for (int i = 0; i < count; ++i) {
+            char* end;
+            values[i] = std::strtoll(text, &end, 10);
+            if (end == text || *end != (i + 1 < count ? ',' : '\0')) {
+                std::fprintf(stderr, "--%s needs %d comma-separated numbers\n", name.c_str(), count);
+                return false;
+            }
+            text = end + 1;
+        }
+        return true;
+    }
+
+    // Step a board on one engine and answer region queries about it
+    int StatsCommand(const std::map<std::string, std::string>& options) {
+        int width = static_cast<int>(GetNumber(options, "width", 0));
+        int height = static_cast<int>(GetNumber(options, "height", 0));
+        int generations = static_cast<int>(GetNumber(options, "generations", 0));
+        int density = static_cast<int>(GetNumber(options, "density", options.count("pattern") != 0 ? 0 : 45));
+        int seed = static_cast<int>(GetNumber(options, "seed", 1));
+        Topology topology;
+
+        if (width <= 0 || height <= 0 || generations < 0 || !GetTopology(options, topology)) {
+            return PrintUsage();
+        }
+
+        long long region[4] = { 0, 0, height, width };
+        long long next[2] = { 0, 0 };
+        if ((options.count("region") != 0 && !GetNumbers(options, "region", 4, region)) ||
+            (options.count("next") != 0 && !GetNumbers(options, "next", 2, next))) {
+            return 1;
+        }
+
+        EngineKind kind = EngineKind::Automatic;
+        auto engineOption = options.find("engine");
+        if (engineOption != options.end() && !ParseEngineKind(engineOption->second, kind)) {
+            std::fprintf(stderr, "Unknown engine %s\n", engineOption->second.c_str());
+            return 1;
+        }
+        if (kind == EngineKind::Automatic) {
+            kind = ChooseEngine(width, height, density / 100.0, topology);
+        }
+
+        std::unique_ptr<LifeEngine> engine = CreateEngine(kind);
+        engine->Resize(width, height);
+        engine->SetTopology(topology);
+        if (engine->GetWidth() != width || engine->GetHeight() != height) {
+            std::fprintf(stderr, "The %s engine can't hold a %d x %d board\n", engine->GetName(), width, height);
+            return 1;
+        }
+
+        // A pattern goes in the middle of the board, otherwise fill it like Randomize Grid
+        auto patternOption = options.find("pattern");
+        if (patternOption != options.end()) {
+            std::vector<std::vector<bool>> pattern;
+            if (!LoadCellsPattern(patternOption->second, pattern) || pattern.empty()) {
+                std::fprintf(stderr, "Failed to load pattern %s\n", patternOption->second.c_str());
+                return 1;
+            }
+
+            int startRow = (height - static_cast<int>(pattern.size())) / 2;
+            int startCol = (width - static_cast<int>(pattern[0].size())) / 2;
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                for (size_t j = 0; j < pattern[i].size(); ++j) {
+                    int row = startRow + static_cast<int>(i);
+                    int col = startCol + static_cast<int>(j);
+                    if (pattern[i][j] && row >= 0 && row < height && col >= 0 && col < width) {
+                        engine->SetCell(row, col, true);
+                    }
+                }
+            }
+        }
+        else {
+            srand(seed);
+            for (int row = 0; row < height; ++row) {
+                for (int col = 0; col < width; ++col) {
+                    if ((rand() % 100) < density) {
+                        engine->SetCell(row, col, true);
+                    }
+                }
+            }
+        }
+
+        auto stepStart = std::chrono::steady_clock::now();
+        engine->Step(generations);
+        double stepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+
+        // The first round of queries pays for bringing the engine's summary up to date
+        bool hasBounds = false, hasNext = false;
+        int top = 0, left = 0, bottom = 0, right = 0, nextRow = 0, nextCol = 0;
+        long long regionCount = 0;
+        double querySeconds[2];
+        for (int round = 0; round < 2; ++round) {
+            auto queryStart = std::chrono::steady_clock::now();
+            hasBounds = engine->GetLiveBounds(top, left, bottom, right);
+            regionCount = engine->CountRegion(static_cast<int>(region[0]), static_cast<int>(region[1]),
+                static_cast<int>(region[2]), static_cast<int>(region[3]));
+            nextRow = static_cast<int>(next[0]);
+            nextCol = static_cast<int>(next[1]);
+            hasNext = engine->FindNextLiveCell(nextRow, nextCol);
+            querySeconds[round] = std::chrono::duration<double>(std::chrono::steady_clock::now() - queryStart).count();
+        }
+
+        std::printf("Board: %d x %d (%s) | %s engine | %d generations in %.3f s\n",
+            width, height, GetTopologyName(topology), engine->GetName(), generations, stepSeconds);
+        std::printf("Living Cells: %lld\n", engine->Population());
+        if (hasBounds) {
+            std::printf("Live Area: rows %d-%d, columns %d-%d\n", top, bottom, left, right);
+        }
+        else {
+            std::printf("Live Area: none\n");
+        }
+        std::printf("Region %lld,%lld %lld x %lld: %lld living cells\n", region[0], region[1], region[2], region[3], regionCount);
+        if (hasNext) {
+            std::printf("Next living cell from %lld,%lld: %d,%d\n", next[0], next[1], nextRow, nextCol);
+        }
+        else {
+            std::printf("Next living cell from %lld,%lld: none\n", next[0], next[1]);
+        }
+        std::printf("Queries: %.1f us after the step, %.1f us repeated\n", querySeconds[0] * 1e6, querySeconds[1] * 1e6);
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return PrintUsage();
+    }
+
+    std::string command = argv[1];
+    std::map<std::string, std::string> options = ParseOptions(argc, argv, 2);
+
+    if (command == "run") {
+        return RunCommand(options);
+    }
+    if (command == "bench") {
+        return BenchCommand(options);
+    }
+    if (command == "verify") {
+        return VerifyCommand(options);
+    }
+    if (command == "sweep") {
+        return SweepCommand(options);
+    }
+    if (command == "stats") {
+        return StatsCommand(options);
+    }
+
+    return PrintUsage();
+}
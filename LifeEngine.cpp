@@ -0,0 +1,118 @@
+#include "LifeEngine.h"
+
+// Copy a rectangle of cells out of the engine (cells off the board read as dead)
+void LifeEngine::ExportRegion(int row, int col, int rows, int cols, std::vector<std::vector<bool>>& region) const {
+    region.assign(rows, std::vector<bool>(cols, false));
+
+    for (int i = 0; i < rows; ++i) {
+        int boardRow = row + i;
+        if (boardRow < 0 || boardRow >= GetHeight()) continue;
+
+        for (int j = 0; j < cols; ++j) {
+            int boardCol = col + j;
+            if (boardCol >= 0 && boardCol < GetWidth() && GetCell(boardRow, boardCol)) {
+                region[i][j] = true;
+            }
+        }
+    }
+}
+
+// Hash of the board contents, packing cells into words one at a time
+uint64_t LifeEngine::Hash() const {
+    int width = GetWidth();
+    int height = GetHeight();
+    uint64_t hash = HashSeed(width, height);
+
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; col += 64) {
+            uint64_t word = 0;
+            for (int bit = 0; bit < 64 && col + bit < width; ++bit) {
+                if (GetCell(row, col + bit)) {
+                    word |= 1ULL << bit;
+                }
+            }
+            hash = HashWord(hash, word);
+        }
+    }
+
+    return hash;
+}
+
+// Living cells in a rectangle (clipped to the board), counted one cell at a time
+long long LifeEngine::CountRegion(int row, int col, int rows, int cols) const {
+    int top = row > 0 ? row : 0;
+    int left = col > 0 ? col : 0;
+    long long bottom = static_cast<long long>(row) + rows;
+    long long right = static_cast<long long>(col) + cols;
+    if (bottom > GetHeight()) bottom = GetHeight();
+    if (right > GetWidth()) right = GetWidth();
+
+    long long count = 0;
+    for (int r = top; r < bottom; ++r) {
+        for (int c = left; c < right; ++c) {
+            count += GetCell(r, c) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+// Smallest rectangle holding every living cell, scanning the whole board
+bool LifeEngine::GetLiveBounds(int& top, int& left, int& bottom, int& right) const {
+    bool found = false;
+    for (int row = 0; row < GetHeight(); ++row) {
+        for (int col = 0; col < GetWidth(); ++col) {
+            if (!GetCell(row, col)) continue;
+
+            if (!found) {
+                top = bottom = row;
+                left = right = col;
+                found = true;
+            }
+            bottom = row;
+            left = col < left ? col : left;
+            right = col > right ? col : right;
+        }
+    }
+    return found;
+}
+
+// First living cell at or after (row, col) in row-major order, scanning from there
+bool LifeEngine::FindNextLiveCell(int& row, int& col) const {
+    int r = row;
+    int c = col > 0 ? col : 0;
+    if (r < 0) {
+        r = 0;
+        c = 0;
+    }
+
+    for (; r < GetHeight(); ++r, c = 0) {
+        for (; c < GetWidth(); ++c) {
+            if (GetCell(r, c)) {
+                row = r;
+                col = c;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Load every cell from a 2D vector board (the GUI's representation)
+void LifeEngine::LoadBoard(const std::vector<std::vector<bool>>& board) {
+    int height = static_cast<int>(board.size());
+    int width = height > 0 ? static_cast<int>(board[0].size()) : 0;
+    if (width != GetWidth() || height != GetHeight()) {
+        Resize(width, height);
+    }
+    else {
+        Clear();
+    }
+
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width && col < static_cast<int>(board[row].size()); ++col) {
+            if (board[row][col]) {
+                SetCell(row, col, true);
+            }
+        }
+    }
+}
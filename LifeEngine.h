@@ -0,0 +1,58 @@
+#ifndef LIFEENGINE_H
+#define LIFEENGINE_H
+
+#include "Topology.h"  // How the board edges are joined
+#include <cstdint>     // Fixed-width integer types for board hashes
+#include <vector>      // STL vector for exported regions
+
+// Common interface for the algorithms that step a board. The GUI, the command line tool and
+// the differential tests only talk to this interface, so a faster engine can be dropped in
+// without touching them. Every engine must produce exactly the same boards as NaiveEngine.
+class LifeEngine {
+public:
+    virtual ~LifeEngine() {}
+
+    virtual const char* GetName() const = 0;         // Human readable engine name
+
+    virtual void Resize(int width, int height) = 0;  // Change the board size, killing every cell
+    virtual int GetWidth() const = 0;
+    virtual int GetHeight() const = 0;
+    virtual void SetTopology(Topology topology) = 0; // How the board edges are joined
+
+    virtual bool GetCell(int row, int col) const = 0;
+    virtual void SetCell(int row, int col, bool alive) = 0;
+    virtual void Clear() = 0;                        // Kill every cell
+
+    virtual void Step(int generations) = 0;          // Advance the board by a number of generations
+    virtual long long Population() const = 0;        // Count living cells
+
+    // Copy a rectangle of cells out of the engine (cells off the board read as dead)
+    virtual void ExportRegion(int row, int col, int rows, int cols, std::vector<std::vector<bool>>& region) const;
+
+    // Hash of the board contents. All engines hash the same packed layout (rows of 64-cell
+    // words, bit j = column w * 64 + j), so equal boards give equal hashes across engines.
+    virtual uint64_t Hash() const;
+
+    // Region queries. These defaults scan the cells; engines that keep a SummaryIndex answer them
+    // in time logarithmic in the board size.
+    virtual long long CountRegion(int row, int col, int rows, int cols) const;        // Living cells in a rectangle (clipped to the board)
+    virtual bool GetLiveBounds(int& top, int& left, int& bottom, int& right) const;   // Smallest rectangle holding every living cell, false if none
+    virtual bool FindNextLiveCell(int& row, int& col) const;  // First living cell at or after (row, col) in row-major order, false if none
+
+    // Load every cell from a 2D vector board (the GUI's representation)
+    void LoadBoard(const std::vector<std::vector<bool>>& board);
+};
+
+// Incremental FNV-1a over 64-bit words, shared by the engines' Hash implementations
+inline uint64_t HashWord(uint64_t hash, uint64_t word) {
+    return (hash ^ word) * 1099511628211ULL;
+}
+
+// Starting value for a board hash of the given size
+inline uint64_t HashSeed(int width, int height) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = HashWord(hash, static_cast<uint64_t>(width));
+    return HashWord(hash, static_cast<uint64_t>(height));
+}
+
+#endif // LIFEENGINE_H
@@ -5,6 +5,7 @@
 #include "play.xpm"      // Bitmap for the Play button
 #include "next.xpm"      // Bitmap for the Next button
 #include "trash.xpm"     // Bitmap for the Clear button
+#include "FixedEngine.h"  // FixedEngine::MaxSize, for explaining a refused board size
 
 // Event table linking menu IDs to event handler functions
 wxBEGIN_EVENT_TABLE(MainWindow, wxFrame)
@@ -23,6 +24,8 @@ EVT_MENU(ID_RANDOMIZE, MainWindow::OnRandomize)            // Randomize the grid
 EVT_MENU(ID_RANDOMIZE_WITH_SEED, MainWindow::OnRandomizeWithSeed)  // Randomize with a custom seed
 EVT_MENU(ID_VIEW_FINITE, MainWindow::OnSetFinite)          // Set universe to finite boundary
 EVT_MENU(ID_VIEW_TOROIDAL, MainWindow::OnSetToroidal)      // Set universe to toroidal boundary
+EVT_MENU(ID_VIEW_CYLINDER, MainWindow::OnSetCylinder)      // Set universe to cylinder boundary
+EVT_MENU(ID_VIEW_KLEIN_BOTTLE, MainWindow::OnSetKleinBottle)  // Set universe to Klein bottle boundary
 EVT_MENU(ID_RESET_SETTINGS, MainWindow::OnResetSettings)   // Reset settings to default
 EVT_MENU(ID_IMPORT, MainWindow::ImportGameBoard)           // Import a game board pattern
 EVT_MENU(ID_VIEW_SHOW_GRID, MainWindow::OnToggleShowGrid)  // Toggle grid visibility
@@ -38,10 +41,11 @@ MainWindow::MainWindow(const wxString& title, const wxPoint& pos, const wxSize&
     settings.Load();
 
     // Initialize the game board with the grid size from the settings
-    gameBoard.resize(settings.gridSize, std::vector<bool>(settings.gridSize, false));
+    gameBoard.resize(settings.gridHeight, std::vector<bool>(settings.gridWidth, false));
+    SelectEngine();
 
     // Create the drawing panel and pass references to the game board and settings
-    drawingPanel = new DrawingPanel(this, gameBoard);
+    drawingPanel = new DrawingPanel(this, gameBoard, pendingEdits);
     drawingPanel->SetSettings(&settings);  // Pass settings to the drawing panel
 
     // Create the status bar (bottom bar showing generations and living cell count)
@@ -91,17 +95,28 @@ void MainWindow::InitializeMenuBar() {
     fileMenu->Append(ID_EXIT, "E&xit", "Exit the application");
     menuBar->Append(fileMenu, "&File");
 
-    // View menu: Finite, Toroidal, Show Grid, Show Thick Grid
+    // View menu: Finite, Toroidal, Cylinder, Klein Bottle, Show Grid, Show Thick Grid
     wxMenu* viewMenu = new wxMenu();
     wxMenuItem* finiteItem = new wxMenuItem(viewMenu, ID_VIEW_FINITE, "Finite", "", wxITEM_CHECK);
     finiteItem->SetCheckable(true);
     viewMenu->Append(finiteItem);  // Append the item
-    finiteItem->Check(!settings.isToroidal);  // Check if current setting is Finite
+    finiteItem->Check(settings.GetTopology() == Topology::Finite);  // Check if current setting is Finite
 
     wxMenuItem* toroidalItem = new wxMenuItem(viewMenu, ID_VIEW_TOROIDAL, "Toroidal", "", wxITEM_CHECK);
     toroidalItem->SetCheckable(true);
     viewMenu->Append(toroidalItem);  // Append the item
-    toroidalItem->Check(settings.isToroidal);  // Check if current setting is Toroidal
+    toroidalItem->Check(settings.GetTopology() == Topology::Toroidal);  // Check if current setting is Toroidal
+
+    wxMenuItem* cylinderItem = new wxMenuItem(viewMenu, ID_VIEW_CYLINDER, "Cylinder", "Left and right edges wrap around", wxITEM_CHECK);
+    cylinderItem->SetCheckable(true);
+    viewMenu->Append(cylinderItem);  // Append the item
+    cylinderItem->Check(settings.GetTopology() == Topology::Cylinder);  // Check if current setting is Cylinder
+
+    wxMenuItem* kleinBottleItem = new wxMenuItem(viewMenu, ID_VIEW_KLEIN_BOTTLE, "Klein Bottle",
+        "Edges wrap around, top and bottom mirrored left to right", wxITEM_CHECK);
+    kleinBottleItem->SetCheckable(true);
+    viewMenu->Append(kleinBottleItem);  // Append the item
+    kleinBottleItem->Check(settings.GetTopology() == Topology::KleinBottle);  // Check if current setting is Klein Bottle
 
     wxMenuItem* showGridItem = new wxMenuItem(viewMenu, ID_VIEW_SHOW_GRID, "Show Grid", "", wxITEM_CHECK);
     showGridItem->SetCheckable(true);
@@ -173,18 +188,36 @@ void MainWindow::OnExit(wxCommandEvent& event) {
 
 // Event handler for setting finite universe
 void MainWindow::OnSetFinite(wxCommandEvent& event) {
-    settings.isToroidal = false;
-    wxMenuBar* menuBar = GetMenuBar();
-    menuBar->FindItem(ID_VIEW_TOROIDAL)->Check(false);  // Uncheck Toroidal
-    menuBar->FindItem(ID_VIEW_FINITE)->Check(true);     // Check Finite
+    SetTopology(Topology::Finite);
 }
 
 // Event handler for setting toroidal universe
 void MainWindow::OnSetToroidal(wxCommandEvent& event) {
-    settings.isToroidal = true;
+    SetTopology(Topology::Toroidal);
+}
+
+// Event handler for setting cylinder universe
+void MainWindow::OnSetCylinder(wxCommandEvent& event) {
+    SetTopology(Topology::Cylinder);
+}
+
+// Event handler for setting Klein bottle universe
+void MainWindow::OnSetKleinBottle(wxCommandEvent& event) {
+    SetTopology(Topology::KleinBottle);
+}
+
+// Change how the board edges are joined, keeping exactly one topology checked in the View menu
+void MainWindow::SetTopology(Topology topology) {
+    settings.topology = static_cast<int>(topology);
+    engine->SetTopology(topology);
+
     wxMenuBar* menuBar = GetMenuBar();
-    menuBar->FindItem(ID_VIEW_TOROIDAL)->Check(true);   // Check Toroidal
-    menuBar->FindItem(ID_VIEW_FINITE)->Check(false);    // Uncheck Finite
+    menuBar->FindItem(ID_VIEW_FINITE)->Check(topology == Topology::Finite);
+    menuBar->FindItem(ID_VIEW_TOROIDAL)->Check(topology == Topology::Toroidal);
+    menuBar->FindItem(ID_VIEW_CYLINDER)->Check(topology == Topology::Cylinder);
+    menuBar->FindItem(ID_VIEW_KLEIN_BOTTLE)->Check(topology == Topology::KleinBottle);
+
+    drawingPanel->Refresh();  // The HUD shows the boundary type
 }
 
 // Event handler for importing a game board
@@ -223,23 +256,24 @@ void MainWindow::ImportGameBoard(wxCommandEvent& event) {
     int importCols = importedBoard[0].size();
 
     // Ensure pattern doesn't exceed the current grid size
-    if (importRows > settings.gridSize || importCols > settings.gridSize) {
+    if (importRows > settings.gridHeight || importCols > settings.gridWidth) {
         wxMessageBox("Imported pattern exceeds the grid size. Data may be lost.", "Warning", wxICON_WARNING);
     }
 
     // Optionally: Center the imported pattern inside the grid
-    int startRow = (settings.gridSize - importRows) / 2;
-    int startCol = (settings.gridSize - importCols) / 2;
+    int startRow = (settings.gridHeight - importRows) / 2;
+    int startCol = (settings.gridWidth - importCols) / 2;
 
     // Place the pattern on the current game board without resizing the grid
     for (int i = 0; i < importRows; ++i) {
-        for (int j = 0; j < importCols; ++j) {
-            if (i + startRow < settings.gridSize && j + startCol < settings.gridSize) {
+        for (int j = 0; j < static_cast<int>(importedBoard[i].size()); ++j) {
+            if (i + startRow >= 0 && i + startRow < settings.gridHeight && j + startCol >= 0 && j + startCol < settings.gridWidth) {
                 gameBoard[i + startRow][j + startCol] = importedBoard[i][j];
             }
         }
     }
 
+    SyncEngine();
     drawingPanel->Refresh();  // Redraw the game board to reflect the new pattern
 }
 
@@ -251,6 +285,7 @@ void MainWindow::OnResetSettings(wxCommandEvent& event) {
 
 // Event handler for playing the game (starting the simulation)
 void MainWindow::OnPlay(wxCommandEvent& event) {
+    SelectEngine();  // Each run gets the engine that suits the board as it is now
     timer->Start(settings.interval);  // Start the timer with the interval from settings
 }
 
@@ -290,63 +325,95 @@ void MainWindow::OnTimer(wxTimerEvent& event) {
     NextGeneration();
 }
 
-// Function to advance to the next generation of cells (game logic)
+// Function to advance to the next generation of cells (game logic lives in the engine)
 void MainWindow::NextGeneration() {
-    std::vector<std::vector<bool>> sandbox(gameBoard.size(), std::vector<bool>(gameBoard[0].size(), false));
+    ApplyPendingEdits(false);  // Fold in everything painted since the last generation; the full refresh below repaints it
 
-    for (int row = 0; row < gameBoard.size(); ++row) {
-        for (int col = 0; col < gameBoard[row].size(); ++col) {
-            int livingNeighbors = CountLivingNeighbors(row, col);
+    engine->Step(1);
+    engine->ExportRegion(0, 0, engine->GetHeight(), engine->GetWidth(), gameBoard);
 
-            if (gameBoard[row][col] && (livingNeighbors == 2 || livingNeighbors == 3)) {
-                sandbox[row][col] = true;
-            }
-            else if (!gameBoard[row][col] && livingNeighbors == 3) {
-                sandbox[row][col] = true;
-            }
+    generation++;
+    UpdateStatusBar();
+
+    drawingPanel->Refresh();  // Redraw the game board with the new generation
+}
+
+// Create the engine chosen in settings, or the best one for the board when set to automatic
+void MainWindow::SelectEngine() {
+    int rows = static_cast<int>(gameBoard.size());
+    int cols = rows > 0 ? static_cast<int>(gameBoard[0].size()) : 0;
+
+    EngineKind kind = EngineKind::Automatic;
+    if (settings.engine > 0 && settings.engine < EngineKindCount) {
+        kind = static_cast<EngineKind>(settings.engine);
+    }
+
+    if (kind == EngineKind::Automatic) {
+        long long living = 0;
+        for (const auto& row : gameBoard) {
+            living += std::count(row.begin(), row.end(), true);
         }
+        double density = rows * cols > 0 ? static_cast<double>(living) / (static_cast<double>(rows) * cols) : 0.0;
+        kind = ChooseEngine(cols, rows, density, settings.GetTopology());
     }
 
-    gameBoard.swap(sandbox);
+    if (!engine || kind != engineKind) {
+        engine = CreateEngine(kind);
+        engineKind = kind;
+    }
 
-    generation++;
-    UpdateStatusBar();
+    engine->SetTopology(settings.GetTopology());
+    SyncEngine();
 
-    drawingPanel->Refresh();  // Redraw the game board with the new generation
+    // The fixed-size engine refuses boards over its limit, and the memory-mapped engine can fail to
+    // create its backing file; fall back to an in-memory engine
+    if (engine->GetWidth() != cols || engine->GetHeight() != rows) {
+        if (kind == EngineKind::Fixed && (cols > FixedEngine::MaxSize || rows > FixedEngine::MaxSize)) {
+            wxMessageBox(wxString::Format("The %s engine does not support this board size (%d x %d); it is limited to %d x %d. Using %s instead.",
+                GetEngineKindName(kind), cols, rows, FixedEngine::MaxSize, FixedEngine::MaxSize,
+                GetEngineKindName(EngineKind::BitParallel)), "Warning", wxICON_WARNING);
+        }
+        else {
+            wxMessageBox(wxString::Format("The %s engine could not be created, using %s instead.",
+                GetEngineKindName(kind), GetEngineKindName(EngineKind::BitParallel)), "Warning", wxICON_WARNING);
+        }
+        engine = CreateEngine(EngineKind::BitParallel);
+        engineKind = EngineKind::BitParallel;
+        engine->SetTopology(settings.GetTopology());
+        SyncEngine();
+    }
 }
 
-// Function to count the number of living neighbors around a given cell
-int MainWindow::CountLivingNeighbors(int row, int col) {
-    int livingNeighbors = 0;
+// Copy the game board into the engine after it was changed directly
+void MainWindow::SyncEngine() {
+    engine->LoadBoard(gameBoard);
+}
 
-    for (int i = -1; i <= 1; ++i) {
-        for (int j = -1; j <= 1; ++j) {
-            if (i == 0 && j == 0) continue;  // Skip the current cell
+// Apply every queued cell edit to the game board in one go
+void MainWindow::ApplyPendingEdits(bool refreshCells) {
+    CellEdit edit;
+    bool changed = false;
 
-            int neighborRow = row + i;
-            int neighborCol = col + j;
+    while (pendingEdits.Pop(edit)) {
+        // The grid may have shrunk since the edit was queued
+        if (edit.row >= gameBoard.size() || edit.col >= gameBoard[edit.row].size()) continue;
+        if (gameBoard[edit.row][edit.col] == edit.alive) continue;  // Nothing to change
 
-            if (settings.isToroidal) {
-                // Handle wrapping for toroidal universe
-                if (neighborRow < 0) neighborRow = settings.gridSize - 1;
-                if (neighborRow >= settings.gridSize) neighborRow = 0;
-                if (neighborCol < 0) neighborCol = settings.gridSize - 1;
-                if (neighborCol >= settings.gridSize) neighborCol = 0;
-            }
-            else {
-                // Skip out-of-bounds indices for finite universe
-                if (neighborRow < 0 || neighborRow >= settings.gridSize || neighborCol < 0 || neighborCol >= settings.gridSize) {
-                    continue;
-                }
-            }
+        gameBoard[edit.row][edit.col] = edit.alive;
+        engine->SetCell(edit.row, edit.col, edit.alive);
+        changed = true;
 
-            if (gameBoard[neighborRow][neighborCol]) {
-                livingNeighbors++;
-            }
+        if (refreshCells) {
+            drawingPanel->RefreshCell(edit.row, edit.col);  // Repaint only the affected cell
         }
     }
 
-    return livingNeighbors;
+    if (changed) {
+        UpdateStatusBar();
+        if (refreshCells) {
+            drawingPanel->RefreshHud();  // Living Cells and Live Area changed with the edits
+        }
+    }
 }
 
 // Function to clear the game board (reset all cells to dead)
@@ -354,6 +421,7 @@ void MainWindow::ClearBoard() {
     for (auto& row : gameBoard) {
         std::fill(row.begin(), row.end(), false);
     }
+    engine->Clear();
 
     generation = 0;
     livingCells = 0;
@@ -369,7 +437,8 @@ void MainWindow::UpdateStatusBar() {
         livingCells += std::count(row.begin(), row.end(), true);
     }
 
-    wxString statusText = wxString::Format("Generations: %d | Living Cells: %d", generation, livingCells);
+    wxString statusText = wxString::Format("Generations: %d | Living Cells: %d | Engine: %s",
+        generation, livingCells, engine->GetName());
     statusBar->SetStatusText(statusText);
 }
 
@@ -414,11 +483,27 @@ void MainWindow::LoadFromFile(const wxString& fileName) {
         newBoard.push_back(row);
     }
 
-    settings.gridSize = newBoard.size();
-    gameBoard = newBoard;
-
     file.close();
 
+    if (newBoard.empty()) {
+        wxMessageBox("Failed to load the game board.", "Error", wxICON_ERROR);
+        return;
+    }
+
+    // The board takes the file's shape; short rows are padded with dead cells
+    size_t width = 0;
+    for (const auto& row : newBoard) {
+        width = std::max(width, row.size());
+    }
+    for (auto& row : newBoard) {
+        row.resize(width, false);
+    }
+
+    settings.gridWidth = static_cast<int>(width);
+    settings.gridHeight = static_cast<int>(newBoard.size());
+    gameBoard = newBoard;
+    SelectEngine();  // The board size may have changed
+
     Refresh();
 }
 
@@ -444,8 +529,12 @@ void MainWindow::OnOpenSettings(wxCommandEvent& event) {
         settings = tempSettings;
         settings.Save();  // Save settings to a file
 
-        // Reinitialize game board size if grid size has changed
-        gameBoard.resize(settings.gridSize, std::vector<bool>(settings.gridSize, false));
+        // Reinitialize game board size if grid size has changed (both the rows and every row's length)
+        gameBoard.resize(settings.gridHeight);
+        for (auto& row : gameBoard) {
+            row.resize(settings.gridWidth, false);
+        }
+        SelectEngine();  // The engine choice or the board size may have changed
         drawingPanel->SetSettings(&settings);  // Update the drawing panel with the new settings
         drawingPanel->Refresh();  // Redraw the grid
     }
@@ -458,12 +547,13 @@ void MainWindow::OnToggleNeighborCount(wxCommandEvent& event) {
 void MainWindow::RandomizeGrid(int seed) {
     srand(seed);  // Seed the random number generator
 
-    for (int row = 0; row < settings.gridSize; ++row) {
-        for (int col = 0; col < settings.gridSize; ++col) {
+    for (int row = 0; row < settings.gridHeight; ++row) {
+        for (int col = 0; col < settings.gridWidth; ++col) {
             // Randomly set each cell as alive (45% chance) or dead (55% chance)
             gameBoard[row][col] = (rand() % 100) < 45;
         }
     }
+    SyncEngine();
 
     drawingPanel->Refresh();  // Redraw the grid to show the randomized cells
 }
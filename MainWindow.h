@@ -6,6 +6,9 @@
 #include "DrawingPanel.h"        // Custom class that handles rendering the game board
 #include "Settings.h"            // Custom class that holds the application's settings
 #include "SettingsDialog.h"      // Custom dialog for modifying settings
+#include "EditQueue.h"           // Lock-free queue of cell edits painted by the user
+#include "EngineFactory.h"       // Pluggable engines that step the game board
+#include <memory>                // std::unique_ptr for the current engine
 #include <vector>                // STL vector for handling game board data
 
 class MainWindow : public wxFrame {
@@ -36,6 +39,8 @@ public:
     // Event handlers for setting universe boundary types
     void OnSetFinite(wxCommandEvent& event);          // Set universe to finite
     void OnSetToroidal(wxCommandEvent& event);        // Set universe to toroidal
+    void OnSetCylinder(wxCommandEvent& event);        // Set universe to a cylinder
+    void OnSetKleinBottle(wxCommandEvent& event);     // Set universe to a Klein bottle
 
     // Event handlers for file operations
     void OnNew(wxCommandEvent& event);                // Create a new game board
@@ -48,8 +53,12 @@ public:
     void NextGeneration();                            // Calculate and advance to the next generation
     void ClearBoard();                                // Clear the game board, resetting all cells
     void RandomizeGrid(int seed);                     // Populate the game board with random cells
-    int CountLivingNeighbors(int row, int col);       // Count the number of living neighbors for a specific cell
+    void SelectEngine();                              // Create the engine chosen in settings (or the best one for the board)
+    void SyncEngine();                                // Copy the game board into the engine after it was changed directly
+    void SetTopology(Topology topology);              // Change how the board edges are joined and update the View menu
     void UpdateStatusBar();                           // Update the status bar with generation and living cell count
+    void ApplyPendingEdits(bool refreshCells);        // Apply queued cell edits, optionally repainting just those cells
+    bool IsRunning() const { return timer->IsRunning(); }  // True while the timer is advancing generations
 
     // File I/O methods
     void SaveToFile(const wxString& fileName);        // Save the current game board to a file
@@ -58,10 +67,16 @@ public:
 
     int GetGenerationCount() const { return generation; }  // Getter for generation count
     int GetLivingCellsCount() const { return livingCells; }  // Getter for living cells count
+    bool GetLiveBounds(int& top, int& left, int& bottom, int& right) const {  // Rectangle holding every living cell, false if none
+        return engine && engine->GetLiveBounds(top, left, bottom, right);
+    }
 
 private:
     DrawingPanel* drawingPanel;                       // Panel for drawing the game board
     std::vector<std::vector<bool>> gameBoard;         // The game board: a 2D vector of cells (true = alive, false = dead)
+    EditQueue pendingEdits;                           // Cell edits painted by the user, applied between generations
+    std::unique_ptr<LifeEngine> engine;               // Engine that steps the board; gameBoard is the displayed copy
+    EngineKind engineKind = EngineKind::Automatic;    // Kind of the current engine
     int generation = 0;                               // Current generation count
     int livingCells = 0;                              // Number of living cells on the board
     wxStatusBar* statusBar;                           // Status bar to display generation and living cell count
@@ -83,6 +98,8 @@ private:
         ID_EXIT,                                      // Menu ID for exiting the application
         ID_VIEW_FINITE,                               // Menu ID for setting finite universe boundary
         ID_VIEW_TOROIDAL,                             // Menu ID for setting toroidal universe boundary
+        ID_VIEW_CYLINDER,                             // Menu ID for setting cylinder universe boundary
+        ID_VIEW_KLEIN_BOTTLE,                         // Menu ID for setting Klein bottle universe boundary
         ID_RESET_SETTINGS,                            // Menu ID for resetting settings to default
         ID_IMPORT,                                    // Menu ID for importing a game board pattern
         ID_VIEW_SHOW_GRID,                            // Menu ID for toggling grid visibility
@@ -0,0 +1,643 @@
+#include "MappedBoard.h"
+#include "BitKernel.h"   // Bit-parallel rules used to step each tile
+#include "SummaryIndex.h" // Tallies of the tiles written by a step
+#include <algorithm>     // std::min
+#include <cstring>       // std::memcpy / std::memset / std::memcmp
+#include <vector>        // Per-row scratch bitmap
+
+#ifdef _WIN32
+#define NOMINMAX         // Keep windows.h from defining min/max macros
+#include <windows.h>     // CreateFileMapping / MapViewOfFile
+#include <winioctl.h>    // FSCTL_SET_SPARSE
+#else
+#include <fcntl.h>       // open
+#include <sys/mman.h>    // mmap / madvise / msync
+#include <sys/stat.h>    // fstat
+#include <unistd.h>      // ftruncate / close
+#endif
+
+namespace {
+    const uint64_t PageSize = 4096;                                // Section alignment inside the backing file
+    const uint64_t TileBytes = MappedBoard::TileWords * sizeof(uint64_t);
+    const char Magic[8] = { 'G', 'O', 'L', 'T', 'I', 'L', 'E', '1' };
+    const uint64_t ZeroTile[MappedBoard::TileWords] = {};          // Stand-in for tiles with no living cells
+
+    uint64_t RoundUpToPage(uint64_t bytes) {
+        return (bytes + PageSize - 1) / PageSize * PageSize;
+    }
+
+    // Wrap a coordinate onto [0, size) across a joined edge
+    int64_t Wrap(int64_t value, int64_t size) {
+        value %= size;
+        return value < 0 ? value + size : value;
+    }
+}
+
+// On-disk header stored in the first page of the backing file
+struct MappedBoard::Header {
+    char magic[8];                                    // Identifies the file format
+    int64_t width;                                    // Board width in cells
+    int64_t height;                                   // Board height in cells
+    int64_t generation;                               // Generations stepped since the board was created
+    int32_t current;                                  // Which of the two buffers holds the current generation
+    int32_t topology;                                 // Topology the board is stepped under (files from before it was stored read 0, finite)
+};
+
+MappedBoard::MappedBoard() {}
+
+MappedBoard::~MappedBoard() {
+    Close();
+}
+
+// Create a new backing file (or reopen an existing one with the same dimensions and topology)
+bool MappedBoard::Open(const std::string& fileName, int64_t boardWidth, int64_t boardHeight, Topology boardTopology) {
+    Close();
+    if (boardWidth <= 0 || boardHeight <= 0) return false;
+
+    width = boardWidth;
+    height = boardHeight;
+    topology = boardTopology;
+    tilesX = (width + TileSize - 1) / TileSize;
+    tilesY = (height + TileSize - 1) / TileSize;
+
+    // Work out where each section lives in the file
+    uint64_t tileCount = static_cast<uint64_t>(tilesX) * static_cast<uint64_t>(tilesY);
+    occupancyStride = (tilesX + 63) / 64;
+    uint64_t occupancyBytes = RoundUpToPage(static_cast<uint64_t>(occupancyStride) * tilesY * sizeof(uint64_t));
+    uint64_t tileArrayBytes = RoundUpToPage(tileCount * TileBytes);
+
+    occupancyOffset[0] = PageSize;
+    occupancyOffset[1] = occupancyOffset[0] + occupancyBytes;
+    tilesOffset[0] = occupancyOffset[1] + occupancyBytes;
+    tilesOffset[1] = tilesOffset[0] + tileArrayBytes;
+    uint64_t totalSize = tilesOffset[1] + tileArrayBytes;
+
+    bool isNewFile = false;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER existingSize;
+    if (!GetFileSizeEx(file, &existingSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (existingSize.QuadPart == 0) {
+        // Mark the file sparse so tiles that are never written take no disk space
+        DWORD bytesReturned = 0;
+        DeviceIoControl(file, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr);
+
+        LARGE_INTEGER newSize;
+        newSize.QuadPart = static_cast<LONGLONG>(totalSize);
+        if (!SetFilePointerEx(file, newSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+            CloseHandle(file);
+            return false;
+        }
+        isNewFile = true;
+    }
+    else if (static_cast<uint64_t>(existingSize.QuadPart) != totalSize) {
+        CloseHandle(file);
+        return false;  // Existing file belongs to a board of a different size
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(totalSize >> 32), static_cast<DWORD>(totalSize & 0xFFFFFFFF), nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(totalSize));
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<unsigned char*>(view);
+#else
+    int file = open(fileName.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) return false;
+
+    struct stat fileInfo;
+    if (fstat(file, &fileInfo) != 0) {
+        close(file);
+        return false;
+    }
+
+    if (fileInfo.st_size == 0) {
+        // ftruncate leaves a hole, so tiles that are never written take no disk space
+        if (ftruncate(file, static_cast<off_t>(totalSize)) != 0) {
+            close(file);
+            return false;
+        }
+        isNewFile = true;
+    }
+    else if (static_cast<uint64_t>(fileInfo.st_size) != totalSize) {
+        close(file);
+        return false;  // Existing file belongs to a board of a different size
+    }
+
+    // No access pattern is advised for the whole mapping: GetCell/SetCell read at random, and
+    // StepOnce advises each tile row as its sweep reaches and leaves it
+    void* view = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (view == MAP_FAILED) {
+        close(file);
+        return false;
+    }
+
+    fileDescriptor = file;
+    base = static_cast<unsigned char*>(view);
+#endif
+
+    mappedSize = totalSize;
+
+    Header* header = GetHeader();
+    if (isNewFile) {
+        std::memcpy(header->magic, Magic, sizeof(Magic));
+        header->width = width;
+        header->height = height;
+        header->generation = 0;
+        header->current = 0;
+        header->topology = static_cast<int32_t>(topology);
+    }
+    else if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->width != width || header->height != height ||
+             header->topology != static_cast<int32_t>(topology)) {
+        Close();
+        return false;  // Not a board file, or a board of a different shape or topology
+    }
+
+    return true;
+}
+
+// Flush and unmap the backing file
+void MappedBoard::Close() {
+    if (!base) return;
+
+    Flush();
+
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(base, mappedSize);
+    close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+
+    base = nullptr;
+    mappedSize = 0;
+    width = height = 0;
+    tilesX = tilesY = 0;
+    occupancyStride = 0;
+}
+
+// Write dirty pages back to the backing file
+void MappedBoard::Flush() {
+    if (!base) return;
+
+#ifdef _WIN32
+    FlushViewOfFile(base, 0);
+    FlushFileBuffers(static_cast<HANDLE>(fileHandle));
+#else
+    msync(base, mappedSize, MS_SYNC);
+#endif
+}
+
+// Change how the edges are joined; the file records it so a reopen with other edge rules is refused
+void MappedBoard::SetTopology(Topology newTopology) {
+    topology = newTopology;
+    if (base) {
+        GetHeader()->topology = static_cast<int32_t>(topology);
+    }
+}
+
+MappedBoard::Header* MappedBoard::GetHeader() const {
+    return reinterpret_cast<Header*>(base);
+}
+
+int MappedBoard::Current() const {
+    return GetHeader()->current;
+}
+
+int64_t MappedBoard::GetGeneration() const {
+    return base ? GetHeader()->generation : 0;
+}
+
+uint64_t* MappedBoard::Tile(int buffer, int64_t tileRow, int64_t tileCol) const {
+    uint64_t index = static_cast<uint64_t>(tileRow) * tilesX + tileCol;
+    return reinterpret_cast<uint64_t*>(base + tilesOffset[buffer] + index * TileBytes);
+}
+
+uint64_t* MappedBoard::Occupancy(int buffer) const {
+    return reinterpret_cast<uint64_t*>(base + occupancyOffset[buffer]);
+}
+
+bool MappedBoard::IsOccupied(int buffer, int64_t tileRow, int64_t tileCol) const {
+    return (Occupancy(buffer)[tileRow * occupancyStride + tileCol / 64] >> (tileCol % 64)) & 1;
+}
+
+void MappedBoard::SetOccupied(int buffer, int64_t tileRow, int64_t tileCol, bool occupied) {
+    uint64_t& word = Occupancy(buffer)[tileRow * occupancyStride + tileCol / 64];
+    uint64_t bit = 1ULL << (tileCol % 64);
+    if (occupied) {
+        word |= bit;
+    }
+    else {
+        word &= ~bit;
+    }
+}
+
+// Mark every tile in a tile row that has an occupied tile within one step of it,
+// working on whole occupancy words so empty stretches of the board are skipped 64 tiles at a time
+void MappedBoard::NearbyOccupied(int buffer, int64_t tileRow, uint64_t* nearby) const {
+    const uint64_t* occupancy = Occupancy(buffer);
+
+    // OR together the occupancy of the tile rows above, level with and below this one
+    for (int64_t word = 0; word < occupancyStride; ++word) nearby[word] = 0;
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+        int64_t neighborRow = tileRow + dy;
+        bool mirrored = false;
+        if (WrapsRows(topology)) {
+            mirrored = topology == Topology::KleinBottle && (neighborRow < 0 || neighborRow >= tilesY);
+            neighborRow = Wrap(neighborRow, tilesY);
+        }
+        else if (neighborRow < 0 || neighborRow >= tilesY) {
+            continue;
+        }
+
+        const uint64_t* row = occupancy + neighborRow * occupancyStride;
+        if (!mirrored) {
+            for (int64_t word = 0; word < occupancyStride; ++word) nearby[word] |= row[word];
+            continue;
+        }
+
+        // Across the mirrored edge of a Klein bottle, tile t covers the cells of the tiles
+        // holding columns width - 64 - 64t to width - 1 - 64t
+        for (int64_t word = 0; word < occupancyStride; ++word) {
+            for (uint64_t bits = row[word]; bits; bits &= bits - 1) {
+                int64_t tileCol = word * 64 + CountBits((bits & (0 - bits)) - 1);  // Lowest set bit
+                int64_t firstCol = std::max<int64_t>(0, width - TileSize - tileCol * TileSize) / TileSize;
+                int64_t lastCol = (width - 1 - tileCol * TileSize) / TileSize;
+                for (int64_t col = firstCol; col <= lastCol; ++col) {
+                    nearby[col / 64] |= 1ULL << (col % 64);
+                }
+            }
+        }
+    }
+
+    // Spread each marked tile one column left and right
+    uint64_t lastWordMask = LowBits(static_cast<int>(tilesX - (occupancyStride - 1) * 64));
+    bool firstTile = nearby[0] & 1;
+    bool lastTile = (nearby[occupancyStride - 1] >> ((tilesX - 1) % 64)) & 1;
+    uint64_t carryIn = 0;
+
+    for (int64_t word = 0; word < occupancyStride; ++word) {
+        uint64_t value = nearby[word];
+        uint64_t next = word + 1 < occupancyStride ? nearby[word + 1] : 0;
+        nearby[word] = value | (value << 1) | carryIn | (value >> 1) | (next << 63);
+        carryIn = value >> 63;
+    }
+    nearby[occupancyStride - 1] &= lastWordMask;
+
+    // Every topology except the finite one joins the left and right edges
+    if (WrapsColumns(topology)) {
+        if (lastTile) nearby[0] |= 1;
+        if (firstTile) nearby[occupancyStride - 1] |= 1ULL << ((tilesX - 1) % 64);
+    }
+}
+
+// Read one cell
+bool MappedBoard::GetCell(int64_t row, int64_t col) const {
+    if (!base || row < 0 || row >= height || col < 0 || col >= width) return false;
+
+    int buffer = Current();
+    int64_t tileRow = row / TileSize, tileCol = col / TileSize;
+    if (!IsOccupied(buffer, tileRow, tileCol)) return false;  // Don't fault in pages of empty tiles
+
+    return (Tile(buffer, tileRow, tileCol)[row % TileSize] >> (col % TileSize)) & 1;
+}
+
+// Copy one tile of the current generation, or return false if it is unoccupied (without touching its pages)
+bool MappedBoard::ReadTile(int64_t tileRow, int64_t tileCol, uint64_t* words) const {
+    if (!base || tileRow < 0 || tileRow >= tilesY || tileCol < 0 || tileCol >= tilesX) return false;
+
+    int buffer = Current();
+    if (!IsOccupied(buffer, tileRow, tileCol)) return false;
+
+    std::memcpy(words, Tile(buffer, tileRow, tileCol), TileBytes);
+    return true;
+}
+
+// Write one cell
+void MappedBoard::SetCell(int64_t row, int64_t col, bool alive) {
+    if (!base || row < 0 || row >= height || col < 0 || col >= width) return;
+
+    int buffer = Current();
+    int64_t tileRow = row / TileSize, tileCol = col / TileSize;
+    if (!alive && !IsOccupied(buffer, tileRow, tileCol)) return;  // Already dead
+
+    uint64_t& word = Tile(buffer, tileRow, tileCol)[row % TileSize];
+    uint64_t bit = 1ULL << (col % TileSize);
+    if (alive) {
+        word |= bit;
+        SetOccupied(buffer, tileRow, tileCol, true);
+    }
+    else {
+        word &= ~bit;
+
+        // An erased tile must not be streamed every generation; drop it from the occupancy bitmap
+        if (!word && std::memcmp(Tile(buffer, tileRow, tileCol), ZeroTile, TileBytes) == 0) {
+            SetOccupied(buffer, tileRow, tileCol, false);
+        }
+    }
+}
+
+// Kill every cell; only tiles marked as occupied need zeroing
+void MappedBoard::Clear() {
+    if (!base) return;
+
+    for (int buffer = 0; buffer < 2; ++buffer) {
+        uint64_t* occupancy = Occupancy(buffer);
+        for (int64_t tileRow = 0; tileRow < tilesY; ++tileRow) {
+            for (int64_t word = 0; word < occupancyStride; ++word) {
+                uint64_t& bits = occupancy[tileRow * occupancyStride + word];
+                while (bits) {
+                    int64_t tileCol = word * 64 + CountBits((bits & (0 - bits)) - 1);  // Lowest set bit
+                    std::memset(Tile(buffer, tileRow, tileCol), 0, TileBytes);
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    GetHeader()->generation = 0;
+}
+
+// Count living cells (only occupied tiles are read)
+int64_t MappedBoard::Population() const {
+    if (!base) return 0;
+
+    int buffer = Current();
+    const uint64_t* occupancy = Occupancy(buffer);
+    int64_t population = 0;
+
+    for (int64_t tileRow = 0; tileRow < tilesY; ++tileRow) {
+        for (int64_t word = 0; word < occupancyStride; ++word) {
+            uint64_t bits = occupancy[tileRow * occupancyStride + word];
+            while (bits) {
+                int64_t tileCol = word * 64 + CountBits((bits & (0 - bits)) - 1);  // Lowest set bit
+                bits &= bits - 1;
+
+                const uint64_t* tile = Tile(buffer, tileRow, tileCol);
+                for (int row = 0; row < TileWords; ++row) {
+                    population += CountBits(tile[row]);
+                }
+            }
+        }
+    }
+
+    return population;
+}
+
+// Read `count` (1..64) cells of a board row starting at column `start`, all inside the board,
+// with two tile words and a shift
+uint64_t MappedBoard::ReadBits(int64_t row, int64_t start, int count) const {
+    int buffer = Current();
+    int64_t tileRow = row / TileSize;
+    auto tileWord = [&](int64_t tileCol) {
+        return IsOccupied(buffer, tileRow, tileCol) ? Tile(buffer, tileRow, tileCol)[row % TileSize] : 0;
+    };
+
+    int shift = static_cast<int>(start % TileSize);
+    uint64_t bits = tileWord(start / TileSize) >> shift;
+    if (shift != 0 && count > TileSize - shift) {
+        bits |= tileWord(start / TileSize + 1) << (TileSize - shift);
+    }
+    return bits & LowBits(count);
+}
+
+// Read 64 cells starting at (row, col) applying the topology; edge tiles gather their ghost border with these
+uint64_t MappedBoard::GatherWord(int64_t row, int64_t col) const {
+    bool mirrored;
+    if (!MapRow(row, height, topology, mirrored)) {
+        return 0;
+    }
+
+    // A mirrored row holds the same 64 cells in reverse order, counted from the other edge
+    if (mirrored) {
+        col = width - TileSize - col;
+    }
+
+    // Aligned words can be read straight out of the tile; bits past the right edge are always dead,
+    // which is only correct for a finite edge or a word that doesn't reach the edge
+    uint64_t word = 0;
+    if (col >= 0 && col % TileSize == 0 && (col + TileSize <= width || (!WrapsColumns(topology) && col < width))) {
+        int buffer = Current();
+        if (IsOccupied(buffer, row / TileSize, col / TileSize)) {
+            word = Tile(buffer, row / TileSize, col / TileSize)[row % TileSize];
+        }
+    }
+    else if (!WrapsColumns(topology)) {
+        // Only the part inside the board; cells past a finite edge are dead
+        int64_t first = std::max<int64_t>(col, 0), end = std::min<int64_t>(col + TileSize, width);
+        if (first < end) {
+            word = ReadBits(row, first, static_cast<int>(end - first)) << (first - col);
+        }
+    }
+    else {
+        // Runs of cells up to the right edge, continuing from column 0 (several times on boards under 64 wide)
+        int64_t column = col % width;
+        if (column < 0) column += width;
+        for (int filled = 0; filled < TileSize; column = 0) {
+            int count = static_cast<int>(std::min<int64_t>(width - column, TileSize - filled));
+            word |= ReadBits(row, column, count) << filled;
+            filled += count;
+        }
+    }
+
+    return mirrored ? ReverseBits(word) : word;
+}
+
+// Step a tile that is not on the board edge; its eight neighbors are read directly
+bool MappedBoard::StepTile(int64_t tileRow, int64_t tileCol, uint64_t* out) const {
+    int buffer = Current();
+    const uint64_t* around[3][3];
+    for (int dy = 0; dy < 3; ++dy) {
+        for (int dx = 0; dx < 3; ++dx) {
+            int64_t neighborRow = tileRow + dy - 1, neighborCol = tileCol + dx - 1;
+            around[dy][dx] = IsOccupied(buffer, neighborRow, neighborCol) ? Tile(buffer, neighborRow, neighborCol) : ZeroTile;
+        }
+    }
+
+    const uint64_t* west = around[1][0];
+    const uint64_t* center = around[1][1];
+    const uint64_t* east = around[1][2];
+    uint64_t anyAlive = 0;
+
+    for (int row = 0; row < TileWords; ++row) {
+        // Rows above and below come from the neighboring tile row at the tile boundary
+        const uint64_t* northWest = row == 0 ? &around[0][0][TileWords - 1] : &west[row - 1];
+        const uint64_t* north = row == 0 ? &around[0][1][TileWords - 1] : &center[row - 1];
+        const uint64_t* northEast = row == 0 ? &around[0][2][TileWords - 1] : &east[row - 1];
+        const uint64_t* southWest = row == TileWords - 1 ? &around[2][0][0] : &west[row + 1];
+        const uint64_t* south = row == TileWords - 1 ? &around[2][1][0] : &center[row + 1];
+        const uint64_t* southEast = row == TileWords - 1 ? &around[2][2][0] : &east[row + 1];
+
+        out[row] = StepWord(*northWest, *north, *northEast,
+                            west[row], center[row], east[row],
+                            *southWest, *south, *southEast);
+        anyAlive |= out[row];
+    }
+
+    return anyAlive != 0;
+}
+
+// Step a tile on the board edge, gathering its halo through the boundary rules
+bool MappedBoard::StepEdgeTile(int64_t tileRow, int64_t tileCol, uint64_t* out) const {
+    uint64_t words[TileWords + 2], left[TileWords + 2], right[TileWords + 2];
+    int64_t firstRow = tileRow * TileSize - 1;
+    int64_t firstCol = tileCol * TileSize;
+
+    for (int row = 0; row < TileWords + 2; ++row) {
+        words[row] = GatherWord(firstRow + row, firstCol);
+        left[row] = GatherWord(firstRow + row, firstCol - TileSize) & (1ULL << 63);  // Only the cells next to the tile matter
+        right[row] = GatherWord(firstRow + row, firstCol + TileSize) & 1;
+    }
+
+    uint64_t columnMask = LowBits(static_cast<int>(std::min<int64_t>(TileSize, width - firstCol)));
+    uint64_t anyAlive = 0;
+
+    for (int row = 0; row < TileWords; ++row) {
+        if (firstRow + 1 + row >= height) {
+            out[row] = 0;  // Past the bottom edge of the board
+            continue;
+        }
+
+        out[row] = StepWord(left[row], words[row], right[row],
+                            left[row + 1], words[row + 1], right[row + 1],
+                            left[row + 2], words[row + 2], right[row + 2]) & columnMask;
+        anyAlive |= out[row];
+    }
+
+    return anyAlive != 0;
+}
+
+// Page cache hints for one tile row: prefetch the occupied runs ahead of the sweep,
+// and let the OS reclaim the rows the sweep has finished with first.
+// Only occupied runs are advised; reading ahead empty regions would just fill the cache with zeros.
+void MappedBoard::AdviseTileRow(int buffer, int64_t tileRow, bool willNeed) const {
+    if (tileRow < 0 || tileRow >= tilesY) return;
+
+#if defined(_WIN32) || !defined(MADV_COLD)
+    if (!willNeed) return;  // No portable way to demote pages here
+#endif
+
+    const uint64_t* occupancy = Occupancy(buffer) + tileRow * occupancyStride;
+    int64_t tileCol = 0;
+
+    while (tileCol < tilesX) {
+        // Skip whole words of empty tiles at a time
+        uint64_t bits = occupancy[tileCol / 64] >> (tileCol % 64);
+        if (!bits) {
+            tileCol = (tileCol / 64 + 1) * 64;
+            continue;
+        }
+        tileCol += CountBits((bits & (0 - bits)) - 1);
+
+        int64_t runStart = tileCol;
+        while (tileCol < tilesX && IsOccupied(buffer, tileRow, tileCol)) ++tileCol;
+
+        uint64_t offset = static_cast<uint64_t>(reinterpret_cast<unsigned char*>(Tile(buffer, tileRow, runStart)) - base);
+        uint64_t alignedStart = offset / PageSize * PageSize;
+        uint64_t length = offset + (tileCol - runStart) * TileBytes - alignedStart;
+
+#ifdef _WIN32
+#if _WIN32_WINNT >= 0x0602
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = base + alignedStart;
+        range.NumberOfBytes = static_cast<SIZE_T>(length);
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+#elif defined(MADV_COLD)
+        madvise(base + alignedStart, length, willNeed ? MADV_WILLNEED : MADV_COLD);
+#else
+        madvise(base + alignedStart, length, MADV_WILLNEED);
+#endif
+    }
+}
+
+// Stream one generation from the current buffer into the other, tile row by tile row
+void MappedBoard::StepOnce(SummaryIndex* summary) {
+    int source = Current();
+    int target = 1 - source;
+    uint64_t out[TileWords];
+    std::vector<uint64_t> nearby(static_cast<size_t>(occupancyStride));
+
+    AdviseTileRow(source, 0, true);
+    AdviseTileRow(source, 1, true);
+
+    for (int64_t tileRow = 0; tileRow < tilesY; ++tileRow) {
+        AdviseTileRow(source, tileRow + 2, true);  // Keep the page cache two tile rows ahead of the sweep
+
+        bool isEdgeRow = tileRow == 0 || tileRow == tilesY - 1;
+        NearbyOccupied(source, tileRow, nearby.data());
+        const uint64_t* targetOccupancy = Occupancy(target) + tileRow * occupancyStride;
+
+        for (int64_t word = 0; word < occupancyStride; ++word) {
+            // A tile can only come alive if it or one of its neighbors has living cells,
+            // and target tiles that still hold an older generation must be cleared
+            uint64_t work = nearby[word] | targetOccupancy[word];
+
+            while (work) {
+                int64_t tileCol = word * 64 + CountBits((work & (0 - work)) - 1);  // Lowest set bit
+                bool isNearby = (nearby[word] & work & (0 - work)) != 0;
+                work &= work - 1;
+
+                bool anyAlive = false;
+                if (isNearby) {
+                    bool isEdge = isEdgeRow || tileCol == 0 || tileCol == tilesX - 1;
+                    anyAlive = isEdge ? StepEdgeTile(tileRow, tileCol, out) : StepTile(tileRow, tileCol, out);
+                }
+
+                if (anyAlive) {
+                    std::memcpy(Tile(target, tileRow, tileCol), out, TileBytes);
+                    SetOccupied(target, tileRow, tileCol, true);
+                    if (summary) {
+                        summary->TallyTile(static_cast<int>(tileRow), static_cast<int>(tileCol), out);
+                    }
+                }
+                else if (IsOccupied(target, tileRow, tileCol)) {
+                    // Stale data from two generations ago; empty tiles that were never written stay untouched
+                    std::memset(Tile(target, tileRow, tileCol), 0, TileBytes);
+                    SetOccupied(target, tileRow, tileCol, false);
+                }
+            }
+        }
+
+        // Rows behind the sweep won't be read again this generation
+        AdviseTileRow(source, tileRow - 1, false);
+        AdviseTileRow(target, tileRow, false);
+    }
+
+    GetHeader()->current = target;
+    GetHeader()->generation++;
+}
+
+// Advance the board by a number of generations. With a summary index, the living tiles of the
+// last generation are tallied into it as they are written.
+void MappedBoard::Step(int generations, SummaryIndex* summary) {
+    if (!base) return;
+
+    for (int i = 0; i < generations; ++i) {
+        StepOnce(i == generations - 1 ? summary : nullptr);
+    }
+}
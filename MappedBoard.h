@@ -0,0 +1,96 @@
+#ifndef MAPPEDBOARD_H
+#define MAPPEDBOARD_H
+
+#include "Topology.h"  // How the board edges are joined
+#include <cstdint>     // Fixed-width integer types for packed tiles
+#include <string>      // Backing file path
+
+class SummaryIndex;    // Tallies the tiles a step writes
+
+// Out-of-core game board. Cells are packed into 64x64 tiles (one 64-bit word per tile row)
+// that live in a memory-mapped backing file, so boards far bigger than physical RAM can be
+// stepped and the OS page cache decides what stays resident.
+//
+// File layout (every section page aligned):
+//   header | occupancy bitmap A | occupancy bitmap B | tiles A | tiles B
+// Two copies of the board are kept so a generation is read from one and written to the
+// other. Tiles with no live cells are never touched, so on file systems with sparse file
+// support empty regions cost no disk space.
+class MappedBoard {
+public:
+    static const int TileSize = 64;                   // Tiles are TileSize x TileSize cells
+    static const int TileWords = TileSize;            // One word per tile row
+
+    MappedBoard();
+    ~MappedBoard();
+
+    MappedBoard(const MappedBoard&) = delete;
+    MappedBoard& operator=(const MappedBoard&) = delete;
+
+    // Create a new backing file (or reopen an existing one with the same dimensions and topology)
+    bool Open(const std::string& fileName, int64_t width, int64_t height, Topology topology);
+    void Close();                                     // Flush and unmap the backing file
+    bool IsOpen() const { return base != nullptr; }
+
+    void SetTopology(Topology newTopology);           // Also recorded in the file, so reopening checks it
+    Topology GetTopology() const { return topology; }
+
+    bool GetCell(int64_t row, int64_t col) const;     // Read one cell
+    void SetCell(int64_t row, int64_t col, bool alive);  // Write one cell
+    void Clear();                                     // Kill every cell
+    void Step(int generations = 1, SummaryIndex* summary = nullptr);  // Advance the board (tallying the last generation's living tiles)
+    int64_t Population() const;                       // Count living cells (only occupied tiles are read)
+    void Flush();                                     // Write dirty pages back to the backing file
+
+    int64_t GetWidth() const { return width; }
+    int64_t GetHeight() const { return height; }
+    int64_t GetGeneration() const;
+
+    // Copy one tile of the current generation, or return false if it is unoccupied (without touching its pages)
+    bool ReadTile(int64_t tileRow, int64_t tileCol, uint64_t* words) const;
+
+private:
+    struct Header;                                    // On-disk header, defined in MappedBoard.cpp
+
+    int64_t width = 0;                                // Board width in cells
+    int64_t height = 0;                               // Board height in cells
+    int64_t tilesX = 0;                               // Tiles per tile row
+    int64_t tilesY = 0;                               // Number of tile rows
+    int64_t occupancyStride = 0;                      // Occupancy words per tile row (each tile row starts on a new word)
+    Topology topology = Topology::Finite;             // How the board edges are joined
+
+    unsigned char* base = nullptr;                    // Start of the mapping
+    uint64_t mappedSize = 0;                          // Length of the mapping in bytes
+    uint64_t occupancyOffset[2] = { 0, 0 };           // File offsets of the two occupancy bitmaps
+    uint64_t tilesOffset[2] = { 0, 0 };               // File offsets of the two tile arrays
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;                       // Windows file handle
+    void* mappingHandle = nullptr;                    // Windows file mapping handle
+#else
+    int fileDescriptor = -1;                          // POSIX file descriptor
+#endif
+
+    Header* GetHeader() const;
+    int Current() const;                              // Index (0/1) of the buffer holding the current generation
+
+    uint64_t* Tile(int buffer, int64_t tileRow, int64_t tileCol) const;
+    uint64_t* Occupancy(int buffer) const;
+    bool IsOccupied(int buffer, int64_t tileRow, int64_t tileCol) const;
+    void SetOccupied(int buffer, int64_t tileRow, int64_t tileCol, bool occupied);
+
+    // Read 64 cells starting at (row, col) applying the topology; edge tiles gather their ghost border with it
+    uint64_t GatherWord(int64_t row, int64_t col) const;
+    uint64_t ReadBits(int64_t row, int64_t start, int count) const;  // Up to 64 cells of one board row, all inside the board
+
+    void StepOnce(SummaryIndex* summary);             // Stream one generation from the current buffer into the other
+    bool StepTile(int64_t tileRow, int64_t tileCol, uint64_t* out) const;  // Returns true if any cell survives
+    bool StepEdgeTile(int64_t tileRow, int64_t tileCol, uint64_t* out) const;
+
+    void AdviseTileRow(int buffer, int64_t tileRow, bool willNeed) const;  // Page cache hints for one tile row
+
+    // Mark every tile in a tile row that has an occupied tile within one step of it
+    void NearbyOccupied(int buffer, int64_t tileRow, uint64_t* nearby) const;
+};
+
+#endif // MAPPEDBOARD_H
@@ -0,0 +1,111 @@
+#include "MappedEngine.h"
+#include <cstdio>        // std::remove / std::fopen
+#include <cstdlib>       // std::getenv
+
+#ifdef _WIN32
+#define NOMINMAX         // Keep windows.h from defining min/max macros
+#include <windows.h>     // GetTempPath / GetTempFileName
+#else
+#include <unistd.h>      // mkstemp / close
+#endif
+
+namespace {
+    // Create an empty file with a unique name in the temp directory, "" on failure
+    std::string CreateTempFile() {
+#ifdef _WIN32
+        char directory[MAX_PATH + 1];
+        char path[MAX_PATH + 1];
+        DWORD length = GetTempPathA(sizeof(directory), directory);
+        if (length == 0 || length > sizeof(directory) || GetTempFileNameA(directory, "gol", 0, path) == 0) {
+            return "";
+        }
+        return path;
+#else
+        const char* directory = std::getenv("TMPDIR");
+        std::string path = std::string(directory && *directory ? directory : "/tmp") + "/gameoflife-XXXXXX";
+        int file = mkstemp(&path[0]);
+        if (file < 0) return "";
+        close(file);
+        return path;
+#endif
+    }
+
+    bool FileExists(const std::string& path) {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file) {
+            std::fclose(file);
+        }
+        return file != nullptr;
+    }
+}
+
+// The summary index reads tiles straight from the mapping, skipping unoccupied ones
+MappedEngine::MappedEngine(const std::string& backingFile)
+    : summary([this](int tileRow, int tileCol, uint64_t* words) { return board.ReadTile(tileRow, tileCol, words); }),
+      requestedFile(backingFile) {
+}
+
+// The backing file only holds this engine's scratch board, so it goes away with the engine
+MappedEngine::~MappedEngine() {
+    board.Close();
+    RemoveOwnFile();
+}
+
+// Change the board size by recreating the backing file
+void MappedEngine::Resize(int width, int height) {
+    board.Close();
+    RemoveOwnFile();
+    summary.Resize(0, 0);
+    if (width <= 0 || height <= 0) return;
+
+    // An existing file at the requested path belongs to someone else: never reuse or delete it
+    if (requestedFile.empty()) {
+        fileName = CreateTempFile();
+    }
+    else if (!FileExists(requestedFile)) {
+        fileName = requestedFile;
+    }
+    if (fileName.empty()) return;
+
+    if (board.Open(fileName, width, height, board.GetTopology())) {
+        summary.Resize(width, height);
+    }
+}
+
+// Edit one cell and mark its leaf for the summary
+void MappedEngine::SetCell(int row, int col, bool alive) {
+    board.SetCell(row, col, alive);
+    if (row >= 0 && row < GetHeight() && col >= 0 && col < GetWidth()) {
+        summary.Invalidate(row, col);
+    }
+}
+
+// Kill every cell
+void MappedEngine::Clear() {
+    board.Clear();
+    summary.Resize(GetWidth(), GetHeight());
+}
+
+// Advance the board. Once the summary has been queried, the last generation's tiles are tallied
+// into it as they are written; until then it is just marked stale.
+void MappedEngine::Step(int generations) {
+    if (generations <= 0 || !board.IsOpen()) return;
+
+    if (!summary.IsQueried()) {
+        board.Step(generations);
+        summary.Invalidate();
+        return;
+    }
+
+    summary.BeginTallies();
+    board.Step(generations, &summary);
+    summary.CommitTallies();
+}
+
+// Delete the backing file if this engine created it
+void MappedEngine::RemoveOwnFile() {
+    if (!fileName.empty()) {
+        std::remove(fileName.c_str());
+        fileName.clear();
+    }
+}
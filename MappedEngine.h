@@ -0,0 +1,49 @@
+#ifndef MAPPEDENGINE_H
+#define MAPPEDENGINE_H
+
+#include "LifeEngine.h"
+#include "MappedBoard.h"
+#include "SummaryIndex.h"  // Population and bounds of the occupied tiles for region queries
+#include <string>
+
+// Engine over an out-of-core MappedBoard. Resizing recreates the backing file: a unique file in
+// the temp directory, or the requested path if nothing exists there yet. Only files the engine
+// created itself are deleted.
+// Region queries go through a summary index with a leaf per tile that reads only occupied tiles.
+// It is held in memory (about an eighth of the packed board), so it is only built by the first
+// query; boards that are just stepped never allocate it.
+class MappedEngine : public LifeEngine {
+public:
+    explicit MappedEngine(const std::string& backingFile);
+    ~MappedEngine();
+
+    const char* GetName() const override { return "Memory-mapped"; }
+
+    void Resize(int width, int height) override;
+    int GetWidth() const override { return static_cast<int>(board.GetWidth()); }
+    int GetHeight() const override { return static_cast<int>(board.GetHeight()); }
+    void SetTopology(Topology topology) override { board.SetTopology(topology); }
+
+    bool GetCell(int row, int col) const override { return board.GetCell(row, col); }
+    void SetCell(int row, int col, bool alive) override;
+    void Clear() override;
+
+    void Step(int generations) override;
+    long long Population() const override { return board.Population(); }
+
+    long long CountRegion(int row, int col, int rows, int cols) const override { return summary.CountRegion(row, col, rows, cols); }
+    bool GetLiveBounds(int& top, int& left, int& bottom, int& right) const override { return summary.GetLiveBounds(top, left, bottom, right); }
+    bool FindNextLiveCell(int& row, int& col) const override { return summary.FindNextLiveCell(row, col); }
+
+    bool IsOpen() const { return board.IsOpen(); }   // False if the backing file couldn't be created
+
+private:
+    MappedBoard board;
+    mutable SummaryIndex summary;                     // Tallied by the step; edited tiles are re-read by the queries
+    std::string requestedFile;                        // Backing file asked for ("" for a temp file)
+    std::string fileName;                             // Backing file this engine created ("" if none)
+
+    void RemoveOwnFile();                             // Delete the backing file if this engine created it
+};
+
+#endif // MAPPEDENGINE_H
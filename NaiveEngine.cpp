@@ -0,0 +1,87 @@
+#include "NaiveEngine.h"
+#include <algorithm>  // std::fill
+
+// Change the board size, killing every cell
+void NaiveEngine::Resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    cells.assign(static_cast<size_t>(width + 2) * (height + 2), 0);
+    sandbox.assign(cells.size(), 0);
+}
+
+// Kill every cell
+void NaiveEngine::Clear() {
+    std::fill(cells.begin(), cells.end(), 0);
+}
+
+// Count living cells
+long long NaiveEngine::Population() const {
+    long long livingCells = 0;
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            livingCells += cells[Index(row, col)];
+        }
+    }
+    return livingCells;
+}
+
+// Advance the board by a number of generations
+void NaiveEngine::Step(int generations) {
+    for (int i = 0; i < generations; ++i) {
+        NextGeneration();
+    }
+}
+
+// Copy the cells the ghost border stands for onto it, following the topology
+void NaiveEngine::FillGhostBorder() {
+    auto fill = [this](int row, int col) {
+        int sourceRow = row, sourceCol = col;
+        bool onBoard = MapCell(sourceRow, sourceCol, width, height, topology);
+        cells[Index(row, col)] = onBoard ? cells[Index(sourceRow, sourceCol)] : 0;
+    };
+
+    for (int col = -1; col <= width; ++col) {
+        fill(-1, col);
+        fill(height, col);
+    }
+    for (int row = 0; row < height; ++row) {
+        fill(row, -1);
+        fill(row, width);
+    }
+}
+
+// Function to advance to the next generation of cells (game logic)
+void NaiveEngine::NextGeneration() {
+    FillGhostBorder();
+
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            int livingNeighbors = CountLivingNeighbors(row, col);
+            bool alive = cells[Index(row, col)] != 0;
+
+            if (alive && (livingNeighbors == 2 || livingNeighbors == 3)) {
+                sandbox[Index(row, col)] = 1;
+            }
+            else if (!alive && livingNeighbors == 3) {
+                sandbox[Index(row, col)] = 1;
+            }
+            else {
+                sandbox[Index(row, col)] = 0;
+            }
+        }
+    }
+
+    cells.swap(sandbox);
+}
+
+// Function to count the number of living neighbors around a given cell.
+// The ghost border makes every cell's neighbors addressable, so there are no edge checks.
+int NaiveEngine::CountLivingNeighbors(int row, int col) const {
+    const unsigned char* above = &cells[Index(row - 1, col)];
+    const unsigned char* current = &cells[Index(row, col)];
+    const unsigned char* below = &cells[Index(row + 1, col)];
+
+    return above[-1] + above[0] + above[1]
+         + current[-1] + current[1]
+         + below[-1] + below[0] + below[1];
+}
@@ -0,0 +1,50 @@
+#ifndef NAIVEENGINE_H
+#define NAIVEENGINE_H
+
+#include "LifeEngine.h"
+#include <cstddef>  // size_t
+#include <vector>
+
+// The original cell-by-cell algorithm: count the eight neighbors of every cell and apply the
+// rules into a sandbox board. Slow, but simple enough to be the reference the other engines
+// are tested against.
+//
+// The board is stored with a one-cell ghost border. Before each generation the border is
+// filled with the cells it stands for under the current topology, so counting neighbors
+// never has to check for the board edge.
+class NaiveEngine : public LifeEngine {
+public:
+    const char* GetName() const override { return "Naive"; }
+
+    void Resize(int width, int height) override;
+    int GetWidth() const override { return width; }
+    int GetHeight() const override { return height; }
+    void SetTopology(Topology newTopology) override { topology = newTopology; }
+
+    bool GetCell(int row, int col) const override { return cells[Index(row, col)] != 0; }
+    void SetCell(int row, int col, bool alive) override { cells[Index(row, col)] = alive ? 1 : 0; }
+    void Clear() override;
+
+    void Step(int generations) override;
+    long long Population() const override;
+
+    // Count the number of living neighbors for a specific cell (reads the ghost border as it was last filled)
+    int CountLivingNeighbors(int row, int col) const;
+
+private:
+    std::vector<unsigned char> cells;                 // The board and its ghost border, row after row (1 = alive)
+    std::vector<unsigned char> sandbox;               // Next generation, same layout
+    int width = 0;
+    int height = 0;
+    Topology topology = Topology::Finite;             // How the board edges are joined
+
+    // Position of a cell in `cells`; rows and columns -1 and width/height are the ghost border
+    size_t Index(int row, int col) const {
+        return static_cast<size_t>(row + 1) * (width + 2) + (col + 1);
+    }
+
+    void FillGhostBorder();                           // Copy the cells the border stands for onto it
+    void NextGeneration();                            // Calculate and advance to the next generation
+};
+
+#endif // NAIVEENGINE_H
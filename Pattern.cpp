@@ -0,0 +1,67 @@
+#include "Pattern.h"
+#include <algorithm>  // std::max
+#include <fstream>    // File streams for reading/writing patterns
+#include <iterator>   // std::istreambuf_iterator
+
+// Load a plaintext .cells pattern
+bool LoadCellsPattern(const std::string& fileName, std::vector<std::vector<bool>>& pattern) {
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ParseCellsPattern(text.data(), text.size(), pattern);
+    return true;
+}
+
+// Parse the same .cells format from text already in memory
+void ParseCellsPattern(const char* data, size_t length, std::vector<std::vector<bool>>& pattern) {
+    pattern.clear();
+    size_t widest = 0;
+    size_t start = 0;
+
+    while (start < length) {
+        size_t end = start;
+        while (end < length && data[end] != '\n') ++end;
+
+        size_t lineEnd = end;
+        if (lineEnd > start && data[lineEnd - 1] == '\r') --lineEnd;  // Tolerate Windows line endings
+
+        // Skip empty lines and comments
+        if (lineEnd > start && data[start] != '!') {
+            std::vector<bool> row;
+            for (size_t i = start; i < lineEnd; ++i) {
+                row.push_back(data[i] == '*');  // '*' is a live cell, '.' is a dead cell
+            }
+            widest = std::max(widest, row.size());
+            pattern.push_back(row);
+        }
+
+        start = end + 1;
+    }
+
+    // Pad ragged rows so the pattern is rectangular
+    for (auto& row : pattern) {
+        row.resize(widest, false);
+    }
+}
+
+// Save a board in the plaintext .cells format
+bool SaveCellsPattern(const std::string& fileName, const std::vector<std::vector<bool>>& pattern) {
+    std::ofstream file(fileName);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    for (const auto& row : pattern) {
+        for (bool cell : row) {
+            file << (cell ? '*' : '.');
+        }
+        file << '\n';
+    }
+
+    return true;
+}
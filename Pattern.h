@@ -0,0 +1,18 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include <cstddef>  // size_t
+#include <string>
+#include <vector>
+
+// Load a plaintext .cells pattern ('*' = alive, '.' = dead, lines starting with '!' are comments).
+// Rows shorter than the widest row are padded with dead cells. Returns false if the file can't be read.
+bool LoadCellsPattern(const std::string& fileName, std::vector<std::vector<bool>>& pattern);
+
+// Parse the same .cells format from text already in memory
+void ParseCellsPattern(const char* data, size_t length, std::vector<std::vector<bool>>& pattern);
+
+// Save a board in the same plaintext .cells format
+bool SaveCellsPattern(const std::string& fileName, const std::vector<std::vector<bool>>& pattern);
+
+#endif // PATTERN_H
@@ -2,17 +2,19 @@
 #define SETTINGS_H
 
 #include "wx/wx.h"
+#include "Topology.h"  // How the board edges are joined
+#include <cstddef>     // offsetof, for recognizing settings files from older versions
 #include <fstream>
 
 // Structure to store the settings of the game
 struct Settings {
-    int gridSize = 15;  // Default grid size (number of cells)
+    int gridWidth = 15;  // Default grid width (number of cells); files from older versions store the square grid size here
     int interval = 50;  // Timer interval in milliseconds for updating the game
     bool showNeighborCount = false;  // Option to show/hide neighbor count
     bool showGrid = true;  // Option to show/hide the grid lines
     bool showThickGrid = false;  // Option to show/hide thicker 10x10 grid lines
     bool showHUD = true;  // Option to show/hide the HUD display (Heads-Up Display)
-    bool isToroidal = false;  // Boundary type (finite or toroidal)
+    bool isToroidal = false;  // Boundary type of files from older versions, replaced by topology
 
     // RGBA values for living and dead cells
     unsigned int livingCellRed = 128;
@@ -25,6 +27,15 @@ struct Settings {
     unsigned int deadCellBlue = 255;
     unsigned int deadCellAlpha = 255;
 
+    int engine = 0;  // Stepping engine (EngineKind value, 0 picks one automatically for each run)
+    int gridHeight = 15;  // Default grid height (number of cells)
+    int topology = 0;  // How the board edges are joined (Topology value)
+
+    // Method to get the topology, falling back to finite for values this version doesn't know
+    Topology GetTopology() const {
+        return topology >= 0 && topology < TopologyCount ? static_cast<Topology>(topology) : Topology::Finite;
+    }
+
     // Method to get wxColour for living cells
     wxColour GetLivingCellColor() const {
         return wxColour(livingCellRed, livingCellGreen, livingCellBlue, livingCellAlpha);
@@ -64,6 +75,12 @@ struct Settings {
         std::ifstream file("settings.bin", std::ios::in | std::ios::binary);
         if (file.is_open()) {
             file.read(reinterpret_cast<char*>(this), sizeof(Settings));
+
+            // Files saved before boards could be rectangular hold one grid size and a toroidal flag
+            if (file.gcount() < static_cast<std::streamsize>(offsetof(Settings, topology) + sizeof(topology))) {
+                gridHeight = gridWidth;
+                topology = static_cast<int>(isToroidal ? Topology::Toroidal : Topology::Finite);
+            }
             file.close();
         }
     }
@@ -1,4 +1,5 @@
 #include "SettingsDialog.h"
+#include "EngineFactory.h"  // Engine names for the engine choice
 
 wxBEGIN_EVENT_TABLE(SettingsDialog, wxDialog)
 EVT_BUTTON(wxID_OK, SettingsDialog::OnOk)
@@ -12,13 +13,20 @@ SettingsDialog::SettingsDialog(wxWindow* parent, Settings* settingsPtr)
     // Main vertical box sizer
     wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
 
-    // Grid Size (using wxSpinCtrl)
-    wxBoxSizer* gridSizeSizer = new wxBoxSizer(wxHORIZONTAL);
-    wxStaticText* gridSizeLabel = new wxStaticText(this, wxID_ANY, "Grid Size: ");
-    gridSizeCtrl = new wxSpinCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 5, 50, settings->gridSize);
-    gridSizeSizer->Add(gridSizeLabel, 0, wxALL, 5);
-    gridSizeSizer->Add(gridSizeCtrl, 0, wxALL, 5);
-    mainSizer->Add(gridSizeSizer, 0, wxEXPAND);
+    // Grid Width and Height (using wxSpinCtrl)
+    wxBoxSizer* gridWidthSizer = new wxBoxSizer(wxHORIZONTAL);
+    wxStaticText* gridWidthLabel = new wxStaticText(this, wxID_ANY, "Grid Width: ");
+    gridWidthCtrl = new wxSpinCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 5, 50, settings->gridWidth);
+    gridWidthSizer->Add(gridWidthLabel, 0, wxALL, 5);
+    gridWidthSizer->Add(gridWidthCtrl, 0, wxALL, 5);
+    mainSizer->Add(gridWidthSizer, 0, wxEXPAND);
+
+    wxBoxSizer* gridHeightSizer = new wxBoxSizer(wxHORIZONTAL);
+    wxStaticText* gridHeightLabel = new wxStaticText(this, wxID_ANY, "Grid Height: ");
+    gridHeightCtrl = new wxSpinCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 5, 50, settings->gridHeight);
+    gridHeightSizer->Add(gridHeightLabel, 0, wxALL, 5);
+    gridHeightSizer->Add(gridHeightCtrl, 0, wxALL, 5);
+    mainSizer->Add(gridHeightSizer, 0, wxEXPAND);
 
     // Interval (using wxSpinCtrl)
     wxBoxSizer* intervalSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -44,6 +52,18 @@ SettingsDialog::SettingsDialog(wxWindow* parent, Settings* settingsPtr)
     deadCellColorSizer->Add(deadCellColorPicker, 0, wxALL, 5);
     mainSizer->Add(deadCellColorSizer, 0, wxEXPAND);
 
+    // Engine (using wxChoice)
+    wxBoxSizer* engineSizer = new wxBoxSizer(wxHORIZONTAL);
+    wxStaticText* engineLabel = new wxStaticText(this, wxID_ANY, "Engine: ");
+    engineChoice = new wxChoice(this, wxID_ANY);
+    for (int kind = 0; kind < EngineKindCount; ++kind) {
+        engineChoice->Append(GetEngineKindName(static_cast<EngineKind>(kind)));
+    }
+    engineChoice->SetSelection(settings->engine >= 0 && settings->engine < EngineKindCount ? settings->engine : 0);
+    engineSizer->Add(engineLabel, 0, wxALL, 5);
+    engineSizer->Add(engineChoice, 0, wxALL, 5);
+    mainSizer->Add(engineSizer, 0, wxEXPAND);
+
     // OK and Cancel buttons
     wxSizer* buttonSizer = CreateButtonSizer(wxOK | wxCANCEL);
     mainSizer->Add(buttonSizer, 0, wxALIGN_CENTER_HORIZONTAL | wxALL, 10);
@@ -56,10 +76,12 @@ SettingsDialog::SettingsDialog(wxWindow* parent, Settings* settingsPtr)
 // Event handler for the OK button
 void SettingsDialog::OnOk(wxCommandEvent& event) {
     // Apply the changes to the settings object
-    settings->gridSize = gridSizeCtrl->GetValue();
+    settings->gridWidth = gridWidthCtrl->GetValue();
+    settings->gridHeight = gridHeightCtrl->GetValue();
     settings->interval = intervalCtrl->GetValue();
     settings->SetLivingCellColor(livingCellColorPicker->GetColour());
     settings->SetDeadCellColor(deadCellColorPicker->GetColour());
+    settings->engine = engineChoice->GetSelection();
 
     // Close the dialog
     EndModal(wxID_OK);
@@ -18,10 +18,12 @@ private:
     Settings* settings;  // Pointer to the settings object
 
     // Controls
-    wxSpinCtrl* gridSizeCtrl;
+    wxSpinCtrl* gridWidthCtrl;
+    wxSpinCtrl* gridHeightCtrl;
     wxSpinCtrl* intervalCtrl;
     wxColourPickerCtrl* livingCellColorPicker;
     wxColourPickerCtrl* deadCellColorPicker;
+    wxChoice* engineChoice;
 
     // Method to initialize controls and set default values
     void InitializeControls();
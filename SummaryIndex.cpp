@@ -0,0 +1,415 @@
+#include "SummaryIndex.h"
+#include <algorithm>    // std::min / std::max / std::sort / std::unique
+
+namespace {
+    typedef SummaryIndex::Rect Rect;
+
+    Rect Intersect(const Rect& a, const Rect& b) {
+        return { std::max(a.top, b.top), std::max(a.left, b.left), std::min(a.bottom, b.bottom), std::min(a.right, b.right) };
+    }
+
+    bool IsEmpty(const Rect& rect) {
+        return rect.top > rect.bottom || rect.left > rect.right;
+    }
+
+    bool Contains(const Rect& outer, const Rect& inner) {
+        return outer.top <= inner.top && outer.left <= inner.left && outer.bottom >= inner.bottom && outer.right >= inner.right;
+    }
+}
+
+// Drop the levels; the next query builds them from the reader
+void SummaryIndex::Resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    levels.clear();
+    levels.shrink_to_fit();
+    staleLeaves.clear();
+    staleLeaves.shrink_to_fit();
+    staleList.clear();
+    tallies.clear();
+    tallies.shrink_to_fit();
+    allStale = false;
+    queried = false;
+
+    tilesX = (width + TileSize - 1) / TileSize;
+    tilesY = (height + TileSize - 1) / TileSize;
+    leavesX = tilesX;
+}
+
+// Allocate the levels for the first query. Nothing was tallied or marked before it, so every
+// leaf is read once through the reader.
+void SummaryIndex::Build() {
+    int levelWidth = tilesX;
+    int levelHeight = tilesY;
+    staleLeaves.assign(static_cast<size_t>(levelWidth) * levelHeight, 0);
+    if (levelWidth == 0 || levelHeight == 0) return;
+
+    for (;;) {
+        Level level;
+        level.width = levelWidth;
+        level.height = levelHeight;
+        level.nodes.resize(static_cast<size_t>(levelWidth) * levelHeight);
+        levels.push_back(level);
+
+        if (levelWidth == 1 && levelHeight == 1) break;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+    allStale = true;
+}
+
+// Every leaf may have changed (the whole board was reloaded)
+void SummaryIndex::Invalidate() {
+    allStale = !levels.empty();
+}
+
+// The leaf holding this cell changed
+void SummaryIndex::Invalidate(int row, int col) {
+    if (allStale || levels.empty()) return;
+
+    int leaf = row / TileSize * leavesX + col / TileSize;
+    if (!staleLeaves[leaf]) {
+        staleLeaves[leaf] = 1;
+        staleList.push_back(leaf);
+    }
+}
+
+// Living cells in a rectangle (clipped to the board)
+long long SummaryIndex::CountRegion(int row, int col, int rows, int cols) {
+    if (rows <= 0 || cols <= 0) return 0;
+    Update();
+    if (levels.empty()) return 0;
+
+    Rect region = {
+        std::max(row, 0), std::max(col, 0),
+        static_cast<int>(std::min<long long>(static_cast<long long>(row) + rows, height) - 1),
+        static_cast<int>(std::min<long long>(static_cast<long long>(col) + cols, width) - 1)
+    };
+    if (IsEmpty(region)) return 0;
+
+    return CountNode(static_cast<int>(levels.size()) - 1, 0, 0, region);
+}
+
+// Smallest rectangle holding every living cell, false if none
+bool SummaryIndex::GetLiveBounds(int& top, int& left, int& bottom, int& right) {
+    Update();
+    if (levels.empty()) return false;
+
+    const Summary& root = levels.back().nodes[0];
+    if (root.population == 0) return false;
+
+    top = root.bounds.top;
+    left = root.bounds.left;
+    bottom = root.bounds.bottom;
+    right = root.bounds.right;
+    return true;
+}
+
+// First living cell at or after (row, col) in row-major order, false if none
+bool SummaryIndex::FindNextLiveCell(int& row, int& col) {
+    Update();
+    if (levels.empty()) return false;
+    if (row < 0) {
+        row = 0;
+        col = 0;
+    }
+    if (row >= height) return false;
+
+    int root = static_cast<int>(levels.size()) - 1;
+
+    // The rest of the starting row
+    int bestCol = INT_MAX;
+    if (col < width) {
+        MinColNode(root, 0, 0, { row, std::max(col, 0), row, width - 1 }, bestCol);
+        if (bestCol != INT_MAX) {
+            col = bestCol;
+            return true;
+        }
+    }
+
+    // Otherwise the first living row below it, and the first living cell in that row
+    int bestRow = INT_MAX;
+    if (row + 1 < height) {
+        MinRowNode(root, 0, 0, { row + 1, 0, height - 1, width - 1 }, bestRow);
+    }
+    if (bestRow == INT_MAX) return false;
+
+    MinColNode(root, 0, 0, { bestRow, 0, bestRow, width - 1 }, bestCol);
+    row = bestRow;
+    col = bestCol;
+    return true;
+}
+
+// Start tallying the next generation: every leaf empty
+void SummaryIndex::BeginTallies() {
+    tallies.assign(levels.empty() ? 0 : levels[0].nodes.size(), Tally());
+}
+
+// Rewrite the leaves whose tally differs from their summary and recombine only their ancestors.
+// The tallies cover the whole new board, so stale leaves are settled by them too.
+void SummaryIndex::CommitTallies() {
+    if (levels.empty()) return;
+
+    std::vector<int> changed;
+    std::vector<Summary>& leaves = levels[0].nodes;
+    for (size_t leaf = 0; leaf < leaves.size(); ++leaf) {
+        Tally& tally = tallies[leaf];
+        if (tally.columns) {
+            Add(tally, tally.bounds.top, static_cast<int>(leaf % leavesX) * TileSize, 1, tally.columns, 0);
+        }
+
+        Summary summary;
+        if (tally.population > 0) {
+            summary.population = tally.population;
+            summary.bounds = tally.bounds;
+        }
+
+        const Summary& old = leaves[leaf];
+        bool same = old.population == summary.population && old.bounds.top == summary.bounds.top &&
+            old.bounds.left == summary.bounds.left && old.bounds.bottom == summary.bounds.bottom &&
+            old.bounds.right == summary.bounds.right;
+        if (!same || allStale || staleLeaves[leaf]) {
+            leaves[leaf] = summary;
+            changed.push_back(static_cast<int>(leaf));
+        }
+        staleLeaves[leaf] = 0;
+    }
+    staleList.clear();
+
+    if (allStale) {
+        // Every node above the leaves is out of date, not just the changed ones
+        allStale = false;
+        changed.resize(leaves.size());
+        for (size_t leaf = 0; leaf < leaves.size(); ++leaf) {
+            changed[leaf] = static_cast<int>(leaf);
+        }
+    }
+    Recombine(changed);
+}
+
+// Bring every stale leaf and its ancestors up to date, building the levels on the first query
+void SummaryIndex::Update() {
+    if (!queried) {
+        queried = true;
+        Build();
+    }
+    if (allStale) {
+        std::vector<int> leaves(levels[0].nodes.size());
+        for (size_t leaf = 0; leaf < leaves.size(); ++leaf) {
+            staleLeaves[leaf] = 0;
+            leaves[leaf] = static_cast<int>(leaf);
+            SummarizeLeaf(static_cast<int>(leaf) / leavesX, static_cast<int>(leaf) % leavesX);
+        }
+        staleList.clear();
+        allStale = false;
+        Recombine(leaves);
+        return;
+    }
+
+    if (staleList.empty()) return;
+
+    std::vector<int> leaves;
+    leaves.swap(staleList);
+    for (int leaf : leaves) {
+        staleLeaves[leaf] = 0;
+        SummarizeLeaf(leaf / leavesX, leaf % leavesX);
+    }
+    Recombine(leaves);
+}
+
+// Recompute every ancestor of these leaves, each once
+void SummaryIndex::Recombine(std::vector<int>& nodes) {
+    for (size_t level = 1; level < levels.size() && !nodes.empty(); ++level) {
+        int childWidth = levels[level - 1].width;
+        for (int& node : nodes) {
+            node = node / childWidth / 2 * levels[level].width + node % childWidth / 2;
+        }
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        for (int node : nodes) {
+            Combine(static_cast<int>(level), node / levels[level].width, node % levels[level].width);
+        }
+    }
+}
+
+// Re-read a leaf (one tile) through the tile reader
+void SummaryIndex::SummarizeLeaf(int leafRow, int leafCol) {
+    Tally tally;
+    uint64_t words[TileSize];
+    if (reader(leafRow, leafCol, words)) {
+        for (int i = 0; i < TileSize; ++i) {
+            if (words[i]) {
+                Add(tally, leafRow * TileSize + i, leafCol * TileSize, 1, words[i], CountBits(words[i]));
+            }
+        }
+    }
+
+    Summary summary;
+    if (tally.population > 0) {
+        summary.population = tally.population;
+        summary.bounds = tally.bounds;
+    }
+    levels[0].nodes[static_cast<size_t>(leafRow) * leavesX + leafCol] = summary;
+}
+
+// Recompute a node from its (up to four) children
+void SummaryIndex::Combine(int level, int nodeRow, int nodeCol) {
+    const Level& children = levels[level - 1];
+    Summary summary;
+
+    for (int childRow = nodeRow * 2; childRow < nodeRow * 2 + 2 && childRow < children.height; ++childRow) {
+        for (int childCol = nodeCol * 2; childCol < nodeCol * 2 + 2 && childCol < children.width; ++childCol) {
+            const Summary& child = children.nodes[static_cast<size_t>(childRow) * children.width + childCol];
+            if (child.population == 0) continue;
+
+            if (summary.population == 0) {
+                summary.bounds = child.bounds;
+            }
+            else {
+                summary.bounds.top = std::min(summary.bounds.top, child.bounds.top);
+                summary.bounds.left = std::min(summary.bounds.left, child.bounds.left);
+                summary.bounds.bottom = std::max(summary.bounds.bottom, child.bounds.bottom);
+                summary.bounds.right = std::max(summary.bounds.right, child.bounds.right);
+            }
+            summary.population += child.population;
+        }
+    }
+    levels[level].nodes[static_cast<size_t>(nodeRow) * levels[level].width + nodeCol] = summary;
+}
+
+// Read a tile for a query, false if it is empty; `columns` gets the region's columns within the tile
+bool SummaryIndex::ReadTile(int tileRow, int tileCol, const Rect& region, uint64_t* words, uint64_t& columns) {
+    if (!reader(tileRow, tileCol, words)) return false;
+
+    int first = std::max(region.left - tileCol * TileSize, 0);
+    int last = std::min(region.right - tileCol * TileSize, TileSize - 1);
+    columns = LowBits(last + 1) & ~LowBits(first);
+    return true;
+}
+
+// Living cells of a node inside the region
+long long SummaryIndex::CountNode(int level, int nodeRow, int nodeCol, const Rect& region) {
+    const Level& nodes = levels[level];
+    const Summary& summary = nodes.nodes[static_cast<size_t>(nodeRow) * nodes.width + nodeCol];
+    if (summary.population == 0) return 0;
+
+    Rect overlap = Intersect(summary.bounds, region);
+    if (IsEmpty(overlap)) return 0;
+    if (Contains(region, summary.bounds)) return summary.population;
+
+    long long count = 0;
+    if (level == 0) {
+        // The tiles of the leaf that the overlap touches
+        uint64_t words[TileSize], columns;
+        for (int tileRow = overlap.top / TileSize; tileRow <= overlap.bottom / TileSize; ++tileRow) {
+            for (int tileCol = overlap.left / TileSize; tileCol <= overlap.right / TileSize; ++tileCol) {
+                if (!ReadTile(tileRow, tileCol, region, words, columns)) continue;
+
+                int first = std::max(overlap.top, tileRow * TileSize);
+                int last = std::min(overlap.bottom, tileRow * TileSize + TileSize - 1);
+                for (int row = first; row <= last; ++row) {
+                    count += CountBits(words[row - tileRow * TileSize] & columns);
+                }
+            }
+        }
+        return count;
+    }
+
+    const Level& children = levels[level - 1];
+    for (int childRow = nodeRow * 2; childRow < nodeRow * 2 + 2 && childRow < children.height; ++childRow) {
+        for (int childCol = nodeCol * 2; childCol < nodeCol * 2 + 2 && childCol < children.width; ++childCol) {
+            count += CountNode(level - 1, childRow, childCol, region);
+        }
+    }
+    return count;
+}
+
+// Lowest living row of a node inside the region, if lower than `best`
+void SummaryIndex::MinRowNode(int level, int nodeRow, int nodeCol, const Rect& region, int& best) {
+    const Level& nodes = levels[level];
+    const Summary& summary = nodes.nodes[static_cast<size_t>(nodeRow) * nodes.width + nodeCol];
+    if (summary.population == 0) return;
+
+    Rect overlap = Intersect(summary.bounds, region);
+    if (IsEmpty(overlap) || overlap.top >= best) return;
+
+    // The box's top row has a living cell; if the region spans the box's columns it is inside
+    if (region.top <= summary.bounds.top && region.left <= summary.bounds.left && region.right >= summary.bounds.right) {
+        best = summary.bounds.top;
+        return;
+    }
+
+    if (level == 0) {
+        // Tile rows top to bottom; the first one with a living cell in the region has the answer
+        uint64_t words[TileSize], columns;
+        for (int tileRow = overlap.top / TileSize; tileRow <= overlap.bottom / TileSize && tileRow * TileSize < best; ++tileRow) {
+            for (int tileCol = overlap.left / TileSize; tileCol <= overlap.right / TileSize; ++tileCol) {
+                if (!ReadTile(tileRow, tileCol, region, words, columns)) continue;
+
+                int first = std::max(overlap.top, tileRow * TileSize);
+                int last = std::min(overlap.bottom, tileRow * TileSize + TileSize - 1);
+                for (int row = first; row <= last && row < best; ++row) {
+                    if (words[row - tileRow * TileSize] & columns) {
+                        best = row;
+                        break;
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Upper children first, so the lower ones can often be skipped
+    const Level& children = levels[level - 1];
+    for (int childRow = nodeRow * 2; childRow < nodeRow * 2 + 2 && childRow < children.height; ++childRow) {
+        for (int childCol = nodeCol * 2; childCol < nodeCol * 2 + 2 && childCol < children.width; ++childCol) {
+            MinRowNode(level - 1, childRow, childCol, region, best);
+        }
+    }
+}
+
+// Lowest living column of a node inside the region, if lower than `best`
+void SummaryIndex::MinColNode(int level, int nodeRow, int nodeCol, const Rect& region, int& best) {
+    const Level& nodes = levels[level];
+    const Summary& summary = nodes.nodes[static_cast<size_t>(nodeRow) * nodes.width + nodeCol];
+    if (summary.population == 0) return;
+
+    Rect overlap = Intersect(summary.bounds, region);
+    if (IsEmpty(overlap) || overlap.left >= best) return;
+
+    // The box's left column has a living cell; if the region spans the box's rows it is inside
+    if (region.left <= summary.bounds.left && region.top <= summary.bounds.top && region.bottom >= summary.bounds.bottom) {
+        best = summary.bounds.left;
+        return;
+    }
+
+    if (level == 0) {
+        // Tile columns left to right; the first one with a living cell in the region has the answer
+        uint64_t words[TileSize], columns;
+        for (int tileCol = overlap.left / TileSize; tileCol <= overlap.right / TileSize && tileCol * TileSize < best; ++tileCol) {
+            uint64_t living = 0;
+            for (int tileRow = overlap.top / TileSize; tileRow <= overlap.bottom / TileSize; ++tileRow) {
+                if (!ReadTile(tileRow, tileCol, region, words, columns)) continue;
+
+                int first = std::max(overlap.top, tileRow * TileSize);
+                int last = std::min(overlap.bottom, tileRow * TileSize + TileSize - 1);
+                for (int row = first; row <= last; ++row) {
+                    living |= words[row - tileRow * TileSize] & columns;
+                }
+            }
+            if (living) {
+                best = std::min(best, tileCol * TileSize + LowestBit(living));
+            }
+        }
+        return;
+    }
+
+    // Left children first, so the right ones can often be skipped
+    const Level& children = levels[level - 1];
+    for (int childCol = nodeCol * 2; childCol < nodeCol * 2 + 2 && childCol < children.width; ++childCol) {
+        for (int childRow = nodeRow * 2; childRow < nodeRow * 2 + 2 && childRow < children.height; ++childRow) {
+            MinColNode(level - 1, childRow, childCol, region, best);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#ifndef SUMMARYINDEX_H
+#define SUMMARYINDEX_H
+
+#include "BitKernel.h"  // CountBits / LowestBit / HighestBit for tallying words
+#include <climits>     // INT_MAX for empty tallies
+#include <cstddef>     // size_t
+#include <cstdint>     // Fixed-width integer types for tile words
+#include <functional>  // std::function for reading tiles out of the owning engine
+#include <vector>
+
+// Hierarchical summary of where the living cells are, for region queries on big boards.
+// The board is cut into 64 x 64 tiles, one per leaf of the index. Level 0 holds the population
+// and tight bounding box of every tile, and each level above summarizes 2 x 2 nodes of the one
+// below, up to a single root. Queries walk down from the root and stop wherever a node's
+// bounding box settles the answer, so they visit a number of nodes logarithmic in the board
+// size (plus the tiles along the edge of a queried region), instead of scanning every cell.
+//
+// The owning engine keeps the index current in two ways. Step kernels tally every word of the
+// generation they write (BeginTallies, TallyRow or TallyTile, CommitTallies), so after a step
+// only the leaves whose summary changed and their ancestors are rewritten, and the board is
+// never read back. Single cell edits mark their leaf stale instead; stale leaves are re-read
+// through the tile reader the next time a query needs them.
+//
+// The levels take about an eighth of the packed board's size, so they are only allocated by the
+// first query after a resize; until then the index costs nothing.
+class SummaryIndex {
+public:
+    static const int TileSize = 64;                   // Tiles are TileSize x TileSize cells
+
+    // Fill words[i] with row tileRow * 64 + i of a tile, bit j being column tileCol * 64 + j, or
+    // return false for a tile known to be empty (words is then left alone).
+    // Rows and columns past the edge of the board must read as dead.
+    typedef std::function<bool(int tileRow, int tileCol, uint64_t* words)> TileReader;
+
+    struct Rect {
+        int top, left, bottom, right;                 // Inclusive cell coordinates
+    };
+
+    explicit SummaryIndex(const TileReader& reader) : reader(reader) {}
+
+    void Resize(int width, int height);               // Drop the levels; the next query builds them from the reader
+    void Invalidate();                                // Every leaf may have changed (the whole board was reloaded)
+    void Invalidate(int row, int col);                // The leaf holding this cell changed
+
+    long long CountRegion(int row, int col, int rows, int cols);     // Living cells in a rectangle (clipped to the board)
+    bool GetLiveBounds(int& top, int& left, int& bottom, int& right); // Smallest rectangle holding every living cell, false if none
+    bool FindNextLiveCell(int& row, int& col);        // First living cell at or after (row, col) in row-major order, false if none
+
+    // Tallies of the next generation, written by a step kernel. Every living cell of the new
+    // board must be tallied exactly once between BeginTallies and CommitTallies; threads may
+    // tally at once as long as no two of them write rows of the same leaf.
+    void BeginTallies();
+    void CommitTallies();                             // Rewrite the leaves that changed and recombine only their ancestors
+
+    // False until the first query after a resize, which builds the levels. Until then the owner
+    // can skip the tallies (there is nothing to tally into) and just call Invalidate() after a step.
+    bool IsQueried() const { return queried; }
+
+    // Tally words [firstWord, endWord) of one row of the new generation. Word i of a row is tile
+    // column i, so its columns are just OR-ed into that leaf; the bit scans wait for CommitTallies.
+    void TallyRow(int row, const uint64_t* words, int firstWord, int endWord) {
+        Tally* leaves = &tallies[static_cast<size_t>(row / TileSize) * leavesX];
+        for (int word = firstWord; word < endWord; ++word) {
+            uint64_t living = words[word];
+            if (!living) continue;
+
+            Tally& leaf = leaves[word];
+            leaf.population += CountBits(living);
+            leaf.columns |= living;
+            if (row < leaf.bounds.top) leaf.bounds.top = row;
+            if (row > leaf.bounds.bottom) leaf.bounds.bottom = row;
+        }
+    }
+
+    // Tally a whole tile of the new generation (tiles left out are empty)
+    void TallyTile(int tileRow, int tileCol, const uint64_t* words) {
+        long long population = 0;
+        uint64_t columns = 0;
+        int first = TileSize, last = -1;
+        for (int i = 0; i < TileSize; ++i) {
+            if (words[i]) {
+                population += CountBits(words[i]);
+                columns |= words[i];
+                if (first == TileSize) first = i;
+                last = i;
+            }
+        }
+        if (population == 0) return;
+
+        Tally& leaf = tallies[static_cast<size_t>(tileRow) * leavesX + tileCol];
+        Add(leaf, tileRow * TileSize + first, tileCol * TileSize, last - first + 1, columns, population);
+    }
+
+private:
+    struct Summary {
+        long long population = 0;
+        Rect bounds = { 0, 0, -1, -1 };               // Tight box around the living cells (empty if population is 0)
+    };
+
+    struct Tally {
+        long long population = 0;
+        Rect bounds = { INT_MAX, INT_MAX, -1, -1 };   // Grows with every living word added
+        uint64_t columns = 0;                         // OR of the tile's words; CommitTallies turns it into left and right
+    };
+
+    struct Level {
+        int width = 0;                                // Nodes per row
+        int height = 0;                               // Rows of nodes
+        std::vector<Summary> nodes;                   // Row-major
+    };
+
+    TileReader reader;
+    int width = 0;                                    // Board size in cells
+    int height = 0;
+    int tilesX = 0;                                   // Board size in tiles
+    int tilesY = 0;
+    int leavesX = 0;                                  // Leaves per row (tilesX)
+    std::vector<Level> levels;                        // levels[0] is the leaves, levels.back() the root
+    std::vector<unsigned char> staleLeaves;           // 1 for leaves listed in staleList
+    std::vector<int> staleList;                       // Leaves to re-read before the next query
+    bool allStale = false;                            // Re-read everything (cheaper than listing every leaf)
+    bool queried = false;                             // A query has been made since the last resize, so the levels exist
+    std::vector<Tally> tallies;                       // One per leaf, filled by step kernels
+
+    // Add `population` living cells in rows [row, row + rows) to a tally; `columns` is the OR of
+    // their words, which start at column `col`
+    static void Add(Tally& tally, int row, int col, int rows, uint64_t columns, long long population) {
+        tally.population += population;
+        if (row < tally.bounds.top) tally.bounds.top = row;
+        if (row + rows - 1 > tally.bounds.bottom) tally.bounds.bottom = row + rows - 1;
+        int left = col + LowestBit(columns);
+        int right = col + HighestBit(columns);
+        if (left < tally.bounds.left) tally.bounds.left = left;
+        if (right > tally.bounds.right) tally.bounds.right = right;
+    }
+
+    void Build();                                     // Allocate the levels, every leaf stale
+    void Update();                                    // Bring every stale leaf and its ancestors up to date
+    void SummarizeLeaf(int leafRow, int leafCol);     // Re-read a leaf through the tile reader
+    void Combine(int level, int nodeRow, int nodeCol); // Recompute a node from its children
+    void Recombine(std::vector<int>& leaves);         // Recompute every ancestor of these leaves, each once
+
+    long long CountNode(int level, int nodeRow, int nodeCol, const Rect& region);
+    void MinRowNode(int level, int nodeRow, int nodeCol, const Rect& region, int& best);  // Lowest living row in region
+    void MinColNode(int level, int nodeRow, int nodeCol, const Rect& region, int& best);  // Lowest living column in region
+    bool ReadTile(int tileRow, int tileCol, const Rect& region, uint64_t* words, uint64_t& columns);  // Also the region's columns as a mask
+};
+
+#endif // SUMMARYINDEX_H
@@ -0,0 +1,41 @@
+#include "Topology.h"
+#include <cctype>  // std::tolower
+
+namespace {
+    const char* TopologyNames[TopologyCount] = {
+        "Finite", "Toroidal", "Cylinder", "Klein bottle"
+    };
+
+    // Compare ignoring case, spaces and dashes, so "klein-bottle" and "KleinBottle" both match
+    bool SameName(const std::string& name, const char* candidate) {
+        size_t i = 0;
+        for (const char* c = candidate; ; ++c) {
+            while (i < name.size() && (name[i] == ' ' || name[i] == '-')) ++i;
+            while (*c == ' ' || *c == '-') ++c;
+            if (i == name.size() || *c == '\0') {
+                return i == name.size() && *c == '\0';
+            }
+            if (std::tolower(static_cast<unsigned char>(name[i])) != std::tolower(static_cast<unsigned char>(*c))) {
+                return false;
+            }
+            ++i;
+        }
+    }
+}
+
+// Name shown in the menus, HUD and CLI
+const char* GetTopologyName(Topology topology) {
+    int index = static_cast<int>(topology);
+    return index >= 0 && index < TopologyCount ? TopologyNames[index] : "Unknown";
+}
+
+// Inverse of GetTopologyName (case-insensitive)
+bool ParseTopology(const std::string& name, Topology& topology) {
+    for (int index = 0; index < TopologyCount; ++index) {
+        if (SameName(name, TopologyNames[index])) {
+            topology = static_cast<Topology>(index);
+            return true;
+        }
+    }
+    return false;
+}
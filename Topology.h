@@ -0,0 +1,70 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <string>
+
+// How the edges of the board are joined together.
+// The numeric values are stored in settings.bin and used by the C interface, so only ever append to this list.
+enum class Topology {
+    Finite = 0,                                       // Cells off the edge are dead
+    Toroidal,                                         // Left/right and top/bottom edges wrap around
+    Cylinder,                                         // Left/right edges wrap around, top and bottom are finite
+    KleinBottle                                       // Left/right wrap around; top/bottom wrap with the board mirrored left to right
+};
+
+const int TopologyCount = 4;
+
+const char* GetTopologyName(Topology topology);      // Name shown in the menus, HUD and CLI
+bool ParseTopology(const std::string& name, Topology& topology);  // Inverse of GetTopologyName (case-insensitive)
+
+// True if the left and right edges are joined
+inline bool WrapsColumns(Topology topology) {
+    return topology != Topology::Finite;
+}
+
+// True if the top and bottom edges are joined
+inline bool WrapsRows(Topology topology) {
+    return topology == Topology::Toroidal || topology == Topology::KleinBottle;
+}
+
+// Map a row anywhere on the plane onto the board, returns false if it lies off a finite edge.
+// `mirrored` is set if the row was reached across the mirrored edge of a Klein bottle.
+template <typename Index>
+bool MapRow(Index& row, Index height, Topology topology, bool& mirrored) {
+    mirrored = false;
+    if (!WrapsRows(topology)) {
+        return row >= 0 && row < height;
+    }
+
+    Index turns = row / height;
+    if (row % height < 0) --turns;                    // Round towards negative infinity
+    row -= turns * height;
+
+    // Each trip across the top/bottom edge of a Klein bottle mirrors the board
+    mirrored = topology == Topology::KleinBottle && (turns & 1) != 0;
+    return true;
+}
+
+// Map a cell anywhere on the plane onto the board it stands for, returns false if it lies off a finite edge.
+// Engines use this to fill their ghost border; it is too slow to call per neighbor.
+template <typename Index>
+bool MapCell(Index& row, Index& col, Index width, Index height, Topology topology) {
+    bool mirrored;
+    if (!MapRow(row, height, topology, mirrored)) {
+        return false;
+    }
+    if (mirrored) {
+        col = width - 1 - col;
+    }
+
+    if (WrapsColumns(topology)) {
+        col %= width;
+        if (col < 0) col += width;
+    }
+    else if (col < 0 || col >= width) {
+        return false;
+    }
+    return true;
+}
+
+#endif // TOPOLOGY_H
@@ -0,0 +1,173 @@
+#define GOL_BUILDING_LIBRARY
+#include "gameoflife.h"
+#include "BitEngine.h"     // Packed bit-parallel engine (blocked for large boards)
+#include "EngineFactory.h" // Picks the packed engine for the board size
+#include "FixedEngine.h"   // One word per row for boards up to 64 x 64
+#include "Pattern.h"       // .cells parsing
+#include <memory>          // std::unique_ptr for the engine
+#include <new>             // std::nothrow / std::bad_alloc
+
+// The engine is chosen for the board size: small boards get the fixed-size engine, whose step
+// costs far less per call than the bit-parallel engine's. Both keep plain packed rows for gol_board.
+struct gol_universe {
+    std::unique_ptr<LifeEngine> engine;
+    EngineKind kind = EngineKind::BitParallel;
+    long long generation = 0;
+};
+
+int gol_abi_version(void) {
+    return GOL_ABI_VERSION;
+}
+
+gol_universe* gol_create(int width, int height, int topology) {
+    if (width <= 0 || height <= 0 || topology < 0 || topology >= TopologyCount) return nullptr;
+
+    // Exceptions must not cross the C boundary
+    try {
+        std::unique_ptr<gol_universe> universe(new gol_universe());
+        universe->kind = ChoosePackedEngine(width, height, static_cast<Topology>(topology));
+        universe->engine = CreateEngine(universe->kind);
+        universe->engine->Resize(width, height);
+        universe->engine->SetTopology(static_cast<Topology>(topology));
+        return universe.release();
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void gol_destroy(gol_universe* universe) {
+    delete universe;
+}
+
+int gol_clear(gol_universe* universe) {
+    if (!universe) return GOL_ERROR_ARGUMENT;
+
+    universe->engine->Clear();
+    universe->generation = 0;
+    return GOL_OK;
+}
+
+int gol_load_pattern(gol_universe* universe, const char* data, size_t length, int top, int left) {
+    if (!universe || (!data && length > 0)) return GOL_ERROR_ARGUMENT;
+
+    try {
+        std::vector<std::vector<bool>> pattern;
+        ParseCellsPattern(data, length, pattern);
+
+        int width = universe->engine->GetWidth();
+        int height = universe->engine->GetHeight();
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            long long row = static_cast<long long>(top) + static_cast<long long>(i);
+            if (row < 0 || row >= height) continue;
+
+            for (size_t j = 0; j < pattern[i].size(); ++j) {
+                long long col = static_cast<long long>(left) + static_cast<long long>(j);
+                if (col < 0 || col >= width) continue;
+                universe->engine->SetCell(static_cast<int>(row), static_cast<int>(col), pattern[i][j]);
+            }
+        }
+    }
+    catch (const std::bad_alloc&) {
+        return GOL_ERROR_MEMORY;
+    }
+
+    return GOL_OK;
+}
+
+int gol_step(gol_universe* universe, int generations) {
+    if (!universe || generations < 0) return GOL_ERROR_ARGUMENT;
+
+    try {
+        universe->engine->Step(generations);
+    }
+    catch (const std::bad_alloc&) {
+        return GOL_ERROR_MEMORY;  // First step allocates the sandbox
+    }
+
+    universe->generation += generations;
+    return GOL_OK;
+}
+
+int gol_get_cell(const gol_universe* universe, int row, int col) {
+    if (!universe || row < 0 || row >= universe->engine->GetHeight() || col < 0 || col >= universe->engine->GetWidth()) {
+        return GOL_ERROR_ARGUMENT;
+    }
+    return universe->engine->GetCell(row, col) ? 1 : 0;
+}
+
+int gol_set_cell(gol_universe* universe, int row, int col, int alive) {
+    if (!universe || row < 0 || row >= universe->engine->GetHeight() || col < 0 || col >= universe->engine->GetWidth()) {
+        return GOL_ERROR_ARGUMENT;
+    }
+    universe->engine->SetCell(row, col, alive != 0);
+    return GOL_OK;
+}
+
+long long gol_population(const gol_universe* universe) {
+    if (!universe) return GOL_ERROR_ARGUMENT;
+    return universe->engine->Population();
+}
+
+long long gol_generation(const gol_universe* universe) {
+    if (!universe) return GOL_ERROR_ARGUMENT;
+    return universe->generation;
+}
+
+int gol_width(const gol_universe* universe) {
+    return universe ? universe->engine->GetWidth() : GOL_ERROR_ARGUMENT;
+}
+
+int gol_height(const gol_universe* universe) {
+    return universe ? universe->engine->GetHeight() : GOL_ERROR_ARGUMENT;
+}
+
+long long gol_count_region(const gol_universe* universe, int row, int col, int rows, int cols) {
+    if (!universe || rows < 0 || cols < 0) return GOL_ERROR_ARGUMENT;
+
+    try {
+        return universe->engine->CountRegion(row, col, rows, cols);
+    }
+    catch (const std::bad_alloc&) {
+        return GOL_ERROR_MEMORY;  // The summary is built by the first query
+    }
+}
+
+int gol_live_bounds(const gol_universe* universe, int* top, int* left, int* bottom, int* right) {
+    if (!universe || !top || !left || !bottom || !right) return GOL_ERROR_ARGUMENT;
+
+    try {
+        return universe->engine->GetLiveBounds(*top, *left, *bottom, *right) ? 1 : 0;
+    }
+    catch (const std::bad_alloc&) {
+        return GOL_ERROR_MEMORY;
+    }
+}
+
+int gol_next_live_cell(const gol_universe* universe, int* row, int* col) {
+    if (!universe || !row || !col) return GOL_ERROR_ARGUMENT;
+
+    try {
+        return universe->engine->FindNextLiveCell(*row, *col) ? 1 : 0;
+    }
+    catch (const std::bad_alloc&) {
+        return GOL_ERROR_MEMORY;
+    }
+}
+
+const uint64_t* gol_board(const gol_universe* universe, size_t* stride_words) {
+    if (!universe) return nullptr;
+
+    if (universe->kind == EngineKind::Fixed) {
+        if (stride_words) {
+            *stride_words = 1;  // One word per row
+        }
+        return static_cast<const FixedEngine&>(*universe->engine).GetRows();
+    }
+
+    const BitBoard& board = static_cast<const BitEngine&>(*universe->engine).GetBoard();
+    if (stride_words) {
+        *stride_words = static_cast<size_t>(board.GetPitch());  // Rows are padded with the engine's ghost words
+    }
+    return board.Row(0);
+}
@@ -0,0 +1,115 @@
+#ifndef GAMEOFLIFE_H
+#define GAMEOFLIFE_H
+
+/*
+ * Embeddable C interface to the Game of Life engines (libgameoflife).
+ *
+ * The interface is plain C so it can be loaded from any language without wxWidgets or the
+ * GUI classes. Boards are stored packed, 64 cells to a 64-bit word, row after row: bit j of
+ * word w in a row is column w * 64 + j. gol_board() hands out a read-only pointer straight
+ * into that storage, so reading cells costs no copies.
+ *
+ * Functions taking a universe return GOL_OK (0) on success or a negative GOL_ERROR_* code.
+ * A universe must only be used from one thread at a time.
+ */
+
+#include <stddef.h>  /* size_t */
+#include <stdint.h>  /* uint64_t */
+
+#if defined(_WIN32)
+#  if defined(GOL_BUILDING_LIBRARY)
+#    define GOL_API __declspec(dllexport)
+#  else
+#    define GOL_API __declspec(dllimport)
+#  endif
+#else
+#  define GOL_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GOL_ABI_VERSION 1                    /* Bumped whenever the interface changes incompatibly */
+
+#define GOL_OK 0
+#define GOL_ERROR_ARGUMENT -1                /* Null universe, bad size or out-of-range cell */
+#define GOL_ERROR_MEMORY -2                  /* The board could not be allocated */
+
+/* How the board edges are joined (the values of the C++ Topology enum) */
+#define GOL_TOPOLOGY_FINITE 0                /* Cells off the edge are dead */
+#define GOL_TOPOLOGY_TOROIDAL 1              /* Left/right and top/bottom edges wrap around */
+#define GOL_TOPOLOGY_CYLINDER 2              /* Left/right edges wrap around, top and bottom are finite */
+#define GOL_TOPOLOGY_KLEIN_BOTTLE 3          /* Like toroidal, but top/bottom wrap with the board mirrored left to right */
+
+typedef struct gol_universe gol_universe;   /* Opaque handle to a board and its engine */
+
+/* Version of the interface the library was built with; compare against GOL_ABI_VERSION */
+GOL_API int gol_abi_version(void);
+
+/* Create an empty width x height universe with one of the GOL_TOPOLOGY_* topologies;
+   returns NULL on bad arguments or allocation failure */
+GOL_API gol_universe* gol_create(int width, int height, int topology);
+
+/* Free a universe and everything it owns; NULL is ignored */
+GOL_API void gol_destroy(gol_universe* universe);
+
+/* Kill every cell and reset the generation counter */
+GOL_API int gol_clear(gol_universe* universe);
+
+/*
+ * Copy a plaintext .cells pattern ('*' = alive, '.' = dead, '!' starts a comment line) from
+ * memory onto the board with its top-left corner at (top, left). Cells that fall off the board
+ * are clipped; cells inside the pattern's bounding box overwrite the board, both alive and dead.
+ */
+GOL_API int gol_load_pattern(gol_universe* universe, const char* data, size_t length, int top, int left);
+
+/* Advance the universe by a number of generations */
+GOL_API int gol_step(gol_universe* universe, int generations);
+
+/* Read or write a single cell; gol_get_cell returns 1/0, or a negative error code */
+GOL_API int gol_get_cell(const gol_universe* universe, int row, int col);
+GOL_API int gol_set_cell(gol_universe* universe, int row, int col, int alive);
+
+/* Number of living cells, or a negative error code */
+GOL_API long long gol_population(const gol_universe* universe);
+
+/* Generations stepped since the universe was created or cleared */
+GOL_API long long gol_generation(const gol_universe* universe);
+
+GOL_API int gol_width(const gol_universe* universe);
+GOL_API int gol_height(const gol_universe* universe);
+
+/*
+ * Region queries. Boards up to 64 x 64 are simply scanned; larger ones are answered from per-tile
+ * populations and bounding boxes in time logarithmic in the board size. That summary is built by
+ * the first query and then kept up to date by gol_step, so universes that are never queried pay
+ * nothing for it. These calls count as uses of the universe too and must not overlap with other
+ * calls on it.
+ */
+
+/* Living cells in the rows x cols rectangle at (row, col), clipped to the board, or a negative error code */
+GOL_API long long gol_count_region(const gol_universe* universe, int row, int col, int rows, int cols);
+
+/* Smallest rectangle holding every living cell, bounds inclusive: 1 if found, 0 for an empty board, or a negative error code */
+GOL_API int gol_live_bounds(const gol_universe* universe, int* top, int* left, int* bottom, int* right);
+
+/* First living cell at or after (*row, *col) in row-major order, written back to *row and *col:
+   1 if found, 0 if there is none, or a negative error code */
+GOL_API int gol_next_live_cell(const gol_universe* universe, int* row, int* col);
+
+/*
+ * Zero-copy, read-only access to the packed board. Row r starts at board + r * stride, where
+ * stride (written to *stride_words) is the number of 64-bit words from one row to the next
+ * (1 for boards up to 64 x 64, which keep one word per row).
+ * Only the first (width + 63) / 64 words of a row hold cells, and bits past the right edge of
+ * the board are always zero. The pointer stays valid until the next call that steps, clears or
+ * writes to the universe.
+ */
+GOL_API const uint64_t* gol_board(const gol_universe* universe, size_t* stride_words);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GAMEOFLIFE_H */